@@ -9,15 +9,29 @@
 //   a fixed-capacity array, which fits typical small-to-medium fleet sizes and avoids
 //   artificial capacity limits required by fixed-size circular buffers.
 // - O(1) Register (append to tail): Adding a new ambulance at the end of the rotation
-//   is a constant-time pointer update. Display is O(n) which is acceptable for small n.
-// - Simple Memory Management: Compared to arrays, linked nodes require explicit new/delete;
+//   is a constant-time pointer update. Views are paged: a page walks offset + limit nodes.
+// - Side index: hash maps ID -> node and registration -> node are kept in sync with the list,
+//   so assign/lookup/remove and the duplicate-registration check are O(1) for large fleets.
+//   Nodes carry a prev pointer so a node found through the index is unlinked in O(1).
+// - Simple Memory Management: Compared to arrays, linked nodes require explicit allocation;
+//   nodes come from a NodePool (contiguous blocks, free list, bulk reset on clearAll), and
 //   we implement a destructor and clear helpers to avoid leaks. This keeps code focused on
 //   core data structure concepts (no STL containers) as required by the assignment.
 // - Why not priority queue / stack / plain queue? A priority queue addresses urgency (Role 3),
 //   stack is LIFO (wrong semantics), and a plain FIFO queue (non-circular) would require
 //   dequeue/enqueue for rotation; circular linked list is a natural, minimal-cost fit.
+// - Duty status: a DutyClock min-heap of upcoming shift boundaries flips isOnDuty when each
+//   boundary passes and notifies subscribers, instead of re-checking every unit per refresh.
+// - Persistence: register/assign/remove append one entry to data/ambulances.log (O(1));
+//   ambulances.txt is rewritten only when that journal is compacted.
 
 #include "Ambulance.hpp"
+#include "BinarySnapshot.hpp"
+#include "CsvTokenizer.hpp"
+#include "MappedFile.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "PagedView.hpp"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
@@ -29,32 +43,168 @@
 
 using namespace std;
 
+static const char* AMBULANCE_BIN = "data/ambulances.bin";
+
+// Older builds stored an all-day shift as start == end (non-zero); assignShift writes 00:00-24:00,
+// so legacy rows (CSV, .bin, journal replay) are normalised to that as they are loaded.
+static void normaliseShift(int& shiftStart, int& shiftEnd) {
+	if (shiftStart == shiftEnd && shiftStart != 0) {
+		shiftStart = 0;
+		shiftEnd = 1440;
+	}
+}
+
 struct Ambulance::Node {
 	Record data;
 	Node* next;
-	Node(const Record& r): data(r), next(nullptr) {}
+	Node* prev; // Back link: O(1) unlink once the index has found the node
+	multimap<int, Node*>::iterator orderPos; // Entry in byStart
+	Node(const Record& r): data(r), next(nullptr), prev(nullptr) {}
 };
 
-Ambulance::Ambulance(): tail(nullptr), nextId(1) {
-    loadFromFile(); // Automatically load roster when object is created
+Ambulance::Ambulance(): tail(nullptr), nextId(1), journal("data/ambulances.log") {
+    // Boundary events flip the record flag; other subscribers see the same transitions
+    duty.subscribe([this](int id, bool onDuty) {
+        Node* node = findById(id);
+        if (node) node->data.isOnDuty = onDuty;
+    });
+    // Automatically load roster when object is created (binary snapshot when it is current)
+    if (!BinarySnapshot::preferBinary(AMBULANCE_BIN, "data/ambulances.txt") || !loadFromBinary(AMBULANCE_BIN)) {
+        loadFromFile();
+    }
+    // Replay operations logged since the last compaction, then fold them into the CSV
+    if (journal.replay([this](string_view e) { applyJournalEntry(e); }) > 0) {
+        compact();
+    }
 }
 
 Ambulance::~Ambulance() {
+	if (journal.entries() > 0) compact();
 	clearAll();
 }
 
+// JOURNAL PERSISTENCE
+// Entry formats:  R,<ID,Vehicle,Driver,Notes,ShiftStart,ShiftEnd,IsOnDuty>   (register)
+//                 S,<id>,<shiftStart>,<shiftEnd>                           (assign shift)
+//                 X,<id>                                                   (remove)
+
+void Ambulance::logOperation(const string& entry) {
+	if (!journal.append(entry)) { // No journal available: fall back to full rewrite
+		saveToFile();
+		return;
+	}
+	if (journal.needsCompaction()) compact();
+}
+
+void Ambulance::applyJournalEntry(string_view entry) {
+	if (entry.size() < 2 || entry[1] != ',') return;
+	string_view body = string_view(entry).substr(2);
+	if (entry[0] == 'R') {
+		Record r;
+		if (RecordLayout::parseCsv(body, r) && r.id >= nextId) appendNode(r); // Lower IDs already in snapshot
+		return;
+	}
+	CsvTokenizer tok(body);
+	string_view idField, startField, endField;
+	int id, start, end;
+	if (!tok.next(idField) || !parseIntField(idField, id)) return;
+
+	if (entry[0] == 'S' && tok.next(startField) && tok.next(endField) &&
+		parseIntField(startField, start) && parseIntField(endField, end)) {
+		Node* node = findById(id);
+		if (node) setShift(node, start, end);
+	} else if (entry[0] == 'X') {
+		unlinkNode(id); // No-op if the snapshot already dropped it
+	}
+}
+
+void Ambulance::compact() {
+	if (saveToFile()) {
+		saveToBinary(AMBULANCE_BIN); // After the CSV, so the .bin is the newer file
+		journal.truncate();
+	}
+}
+
+void Ambulance::appendNode(const Record& r) {
+	Node* node = pool.create(r);
+	normaliseShift(node->data.shiftStart, node->data.shiftEnd);
+	if (!tail) {
+		node->next = node->prev = node;
+		tail = node;
+	} else {
+		Node* head = tail->next;
+		node->next = head;
+		node->prev = tail;
+		head->prev = node;
+		tail->next = node;
+		tail = node;
+	}
+	byId[r.id] = node;
+	byReg.emplace(r.vehicleReg, node); // First registration wins if a hand-edited file has duplicates
+	const Record& d = node->data;
+	node->orderPos = byStart.emplace(d.shiftStart, node);
+	shifts.set(d.id, d.shiftStart, d.shiftEnd);
+	duty.set(d.id, d.shiftStart, d.shiftEnd, d.isOnDuty, DutyClock::wallClock());
+	nextId = max(nextId, r.id + 1);
+	Metrics::setGauge(Metrics::AMBULANCE_ROSTER, static_cast<long long>(byId.size()));
+}
+
+bool Ambulance::unlinkNode(int id) {
+	auto it = byId.find(id);
+	if (it == byId.end()) return false;
+	Node* cur = it->second;
+	byId.erase(it);
+	auto reg = byReg.find(cur->data.vehicleReg);
+	if (reg != byReg.end() && reg->second == cur) byReg.erase(reg);
+	byStart.erase(cur->orderPos);
+	shifts.erase(id);
+	duty.cancel(id);
+
+	if (cur->next == cur) {
+		tail = nullptr; // single node
+	} else {
+		cur->prev->next = cur->next;
+		cur->next->prev = cur->prev;
+		if (cur == tail) tail = cur->prev; // removed tail
+	}
+	pool.destroy(cur);
+	Metrics::setGauge(Metrics::AMBULANCE_ROSTER, static_cast<long long>(byId.size()));
+	return true;
+}
+
+Ambulance::Node* Ambulance::findById(int id) const {
+	auto it = byId.find(id);
+	return it == byId.end() ? nullptr : it->second;
+}
+
 void Ambulance::clearAll() {
 	if (!tail) return;
-	// Break the circle to iterate and delete
+	// Break the circle to iterate and run the node destructors, then release all slots at once
 	Node* head = tail->next;
 	tail->next = nullptr;
 	Node* cur = head;
 	while (cur) {
 		Node* tmp = cur->next;
-		delete cur;
+		cur->~Node();
 		cur = tmp;
 	}
+	pool.reset();
 	tail = nullptr;
+	byId.clear();
+	byReg.clear();
+	byStart.clear();
+	shifts.clear();
+	duty.clear();
+}
+
+void Ambulance::setShift(Node* node, int shiftStart, int shiftEnd) {
+	normaliseShift(shiftStart, shiftEnd);   // Replayed S entries of older builds
+	node->data.shiftStart = shiftStart;
+	node->data.shiftEnd = shiftEnd;
+	byStart.erase(node->orderPos);
+	node->orderPos = byStart.emplace(shiftStart, node);
+	shifts.set(node->data.id, shiftStart, shiftEnd);
+	duty.set(node->data.id, shiftStart, shiftEnd, node->data.isOnDuty, DutyClock::wallClock());
 }
 
 bool Ambulance::registerAmbulance() {
@@ -75,39 +225,34 @@ bool Ambulance::registerAmbulance() {
 	cout << "Optional notes: ";
 	string notes; getline(cin, notes);
 
+	return registerAmbulance(reg, driver, notes);
+}
+
+bool Ambulance::registerAmbulance(const string& reg, const string& driver, const string& notes) {
+	Metrics::Timer timer(Metrics::REGISTER_AMBULANCE);
+	// Non-interactive core (also used by batch mode): validate, de-duplicate, append, journal.
 	if (reg.empty() || driver.empty()) {
-		cout << "Invalid input. Registration aborted." << endl;
+		Log::error() << "Invalid input. Registration aborted.\n";
 		return false;
 	}
 
-	// Duplicate check by registration string (case-sensitive here)
-	if (tail) {
-		Node* cur = tail->next; // head
-		do {
-			if (cur->data.vehicleReg == reg) {
-				cout << "Ambulance with registration '" << reg << "' already registered." << endl;
-				return false;
-			}
-			cur = cur->next;
-		} while (cur != tail->next);
+	// Duplicate check by registration string (case-sensitive here), O(1) via the index
+	if (byReg.count(reg)) {
+		Log::error() << "Ambulance with registration '" << reg << "' already registered.\n";
+		return false;
 	}
 
-	Record r{ nextId++, reg, driver, notes, 0, 0, false }; // Initialize scheduling fields: shiftStart=0, shiftEnd=0, isOnDuty=false
-	Node* node = new Node(r);
-	if (!tail) {
-		node->next = node;
-		tail = node;
-	} else {
-		node->next = tail->next; // head
-		tail->next = node;
-		tail = node;
-	}
-	cout << "Registered ambulance ID " << r.id << ": " << r.vehicleReg << " (" << r.driverName << ")" << endl;
-	saveToFile(); // Auto-save after registration
+	Record r{ nextId, reg, driver, notes, 0, 0, false }; // Initialize scheduling fields: shiftStart=0, shiftEnd=0, isOnDuty=false
+	appendNode(r);
+	Log::result() << "Registered ambulance ID " << r.id << ": " << r.vehicleReg << " (" << r.driverName << ")\n";
+	string entry = "R,";
+	RecordLayout::appendCsv(entry, r);
+	logOperation(entry); // Auto-save after registration (O(1) journal entry)
 	return true;
 }
 
 bool Ambulance::rotateShift() {
+    Metrics::Timer timer(Metrics::ROTATE_SHIFT);
     // FUNCTIONALITY 2: ROTATE AMBULANCE SHIFT  
     // Purpose: Implement round-robin scheduling for equal duty time
     // Implementation:
@@ -118,15 +263,15 @@ bool Ambulance::rotateShift() {
     // Data Structure Advantage: Circular list enables O(1) rotation vs O(n) array shifting
 
 	if (!tail) {
-		cout << "No ambulances to rotate." << endl;
+		Log::error() << "No ambulances to rotate.\n";
 		return false;
 	}
 	if (tail->next == tail) {
-		cout << "Only one ambulance registered. Rotation is a no-op." << endl;
+		Log::result() << "Only one ambulance registered. Rotation is a no-op.\n";
 		return false;
 	}
 	tail = tail->next; // advance tail so head moves one step
-	cout << "Rotation complete. New head is ambulance ID " << tail->next->data.id << "." << endl;
+	Log::result() << "Rotation complete. New head is ambulance ID " << tail->next->data.id << ".\n";
 	return true;
 }
 
@@ -134,37 +279,52 @@ void Ambulance::displaySchedule() const {
     // CONSOLIDATED DISPLAY: Shows ambulance schedule with all details
     // Purpose: Single comprehensive display supporting multiple views
     // Features:
-    // - Shows all ambulances with complete information
+    // - Shows the ambulances with complete information, one page at a time
     // - Displays rotation order (Head -> Tail) with shift times
     // - Includes on-duty status for easy dispatch decisions
-    // - Sortable by time if needed (rotation order shown by default)
+    // - Sorted by time in displayScheduleByTime() (rotation order shown by default)
 
 	if (!tail) {
-		cout << "No ambulances registered." << endl;
+		cout << "No ambulances registered.\n";
 		return;
 	}
+	PagedView::browse([this](int offset, int limit) { return displaySchedule(offset, limit); });
+}
+
+bool Ambulance::displaySchedule(int offset, int limit) const {
+	// Walk the ring itself from the head: skip offset nodes, print limit (no vector of nodes)
+	ostream& out = Log::result();
+	if (!tail) {
+		out << "No ambulances registered.\n";
+		return false;
+	}
 
-	// Collect ambulances into vector for potential sorting
-	vector<Node*> ambulances;
-	Node* cur = tail->next;
-	do {
-		ambulances.push_back(cur);
+	Node* head = tail->next;
+	Node* cur = head;
+	int skipped = 0;
+	while (skipped < offset && cur != tail) {
 		cur = cur->next;
-	} while (cur != tail->next);
+		skipped++;
+	}
+	if (skipped < offset) {   // offset is past the end of the roster
+		PagedView::footer(out, offset, 0, static_cast<int>(byId.size()), false);
+		return false;
+	}
 
-	cout << "\n[ AMBULANCE SCHEDULE & ROTATION STATUS ]" << endl;
-	cout << left << setw(6) << "ID" << setw(14) << "Vehicle" << setw(18) << "Driver" 
-		 << setw(14) << "Shift" << setw(10) << "On-Duty" << "Notes" << endl;
-	cout << string(95, '-') << endl;
+	out << "\n[ AMBULANCE SCHEDULE & ROTATION STATUS ]\n";
+	out << left << setw(6) << "ID" << setw(14) << "Vehicle" << setw(18) << "Driver" 
+		<< setw(14) << "Shift" << setw(10) << "On-Duty" << "Notes\n";
+	out << string(95, '-') << "\n";
+
+	int shown = 0;
+	bool more = true;
+	while (more && shown < limit) {
+		const Record& r = cur->data;
 
-	// Display in rotation order (head to tail)
-	for (size_t i = 0; i < ambulances.size(); ++i) {
-		const Record& r = ambulances[i]->data;
-		
 		// Display position indicator
 		string position;
-		if (i == 0) position = "[HEAD] ";
-		else if (i == ambulances.size() - 1) position = "[TAIL]";
+		if (cur == head) position = "[HEAD] ";
+		else if (cur == tail) position = "[TAIL]";
 		else position = "       ";
 
 		string shiftTime;
@@ -175,142 +335,118 @@ void Ambulance::displaySchedule() const {
 		}
 		string onDutyStr = r.isOnDuty ? "Yes" : "No";
 		
-		cout << left << setw(6) << r.id << setw(14) << r.vehicleReg << setw(18) << r.driverName 
-			 << setw(14) << shiftTime << setw(10) << onDutyStr << position << r.notes << endl;
+		out << left << setw(6) << r.id << setw(14) << r.vehicleReg << setw(18) << r.driverName 
+			<< setw(14) << shiftTime << setw(10) << onDutyStr << position << r.notes << "\n";
+		shown++;
+		more = cur != tail;
+		cur = cur->next;
 	}
+	PagedView::footer(out, offset, shown, static_cast<int>(byId.size()), more);
+	return more;
 }
 
 bool Ambulance::removeAmbulance(int id) {
 	if (!tail) return false;
-	Node* prev = tail;
-	Node* cur = tail->next; // head
-	do {
-		if (cur->data.id == id) {
-			if (cur == prev) {
-				// single node
-				delete cur;
-				tail = nullptr;
-			} else {
-				prev->next = cur->next;
-				if (cur == tail) tail = prev; // removed tail
-				delete cur;
-			}
-			cout << "Removed ambulance ID " << id << "." << endl;
-			saveToFile(); // Auto-save after removal
-			return true;
-		}
-		prev = cur;
-		cur = cur->next;
-	} while (cur != tail->next);
-	cout << "Ambulance ID " << id << " not found." << endl;
+	if (unlinkNode(id)) {
+		Log::result() << "Removed ambulance ID " << id << ".\n";
+		logOperation("X," + to_string(id)); // Auto-save after removal (O(1) journal entry)
+		return true;
+	}
+	Log::error() << "Ambulance ID " << id << " not found.\n";
 	return false;
 }
 
 bool Ambulance::saveToFile(const string& filename) {
+    Metrics::Timer timer(Metrics::SAVE_AMBULANCES_CSV);
     // Create data/ folder if it doesn't exist (simple approach: try to open and assume folder exists)
-    ofstream file(filename);
+    // Written to a temp file and renamed over the original so a crash never truncates the roster
+    string tmp = filename + ".tmp";
+    ofstream file(tmp);
     if (!file.is_open()) {
-        cout << "Error: Could not open " << filename << " for writing." << endl;
+        Log::error() << "Error: Could not open " << filename << " for writing.\n";
         return false;
     }
     if (!tail) {
-        cout << "No ambulances to save." << endl;
+        Log::status() << "No ambulances to save.\n";
         file.close();
-        return true;
+        return Journal::replaceFile(tmp, filename);
     }
     // Write header
     file << "ID,Vehicle,Driver,Notes,ShiftStart,ShiftEnd,IsOnDuty\n";
     // Iterate and write all nodes
     Node* cur = tail->next; // head
     do {
-        const Record& r = cur->data;
-        file << r.id << ","
-             << r.vehicleReg << ","
-             << r.driverName << ","
-             << r.notes << ","
-             << r.shiftStart << ","
-             << r.shiftEnd << ","
-             << (r.isOnDuty ? "1" : "0") << "\n";
+        RecordLayout::writeCsv(file, cur->data);
+        file << '\n';
         cur = cur->next;
     } while (cur != tail->next);
     file.close();
-    cout << "Saved " << filename << " successfully." << endl;
+    if (!file.good() || !Journal::replaceFile(tmp, filename)) {
+        Log::error() << "Error: Could not write " << filename << ".\n";
+        return false;
+    }
+    Log::status() << "Saved " << filename << " successfully.\n";
     return true;
 }
 
 bool Ambulance::loadFromFile(const string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cout << "Warning: File " << filename << " not found. Starting with empty roster." << endl;
+    Metrics::Timer timer(Metrics::LOAD_AMBULANCES_CSV);
+    MappedFile file;
+    if (!file.open(filename)) {
+        Log::status() << "Warning: File " << filename << " not found. Starting with empty roster.\n";
         return false;
     }
     clearAll(); // Clear current list
-    string line;
-    getline(file, line); // Skip header
-    while (getline(file, line)) {
+    CsvLineReader lines(file.view());
+    string_view line;
+    lines.nextLine(line); // Skip header
+    Record r;
+    while (lines.nextLine(line)) {
         if (line.empty()) continue;
-        // Parse CSV: ID,Vehicle,Driver,Notes,ShiftStart,ShiftEnd,IsOnDuty
-        size_t pos1 = line.find(',');
-        size_t pos2 = line.find(',', pos1 + 1);
-        size_t pos3 = line.find(',', pos2 + 1);
-        size_t pos4 = line.find(',', pos3 + 1);
-        size_t pos5 = line.find(',', pos4 + 1);
-        size_t pos6 = line.find(',', pos5 + 1);
-        
-        if (pos1 == string::npos || pos2 == string::npos || pos3 == string::npos) continue;
-        
-        int id = stoi(line.substr(0, pos1));
-        string vehicle = line.substr(pos1 + 1, pos2 - pos1 - 1);
-        string driver = line.substr(pos2 + 1, pos3 - pos2 - 1);
-        
-        // Handle Notes field (may contain commas or may not exist in old format)
-        string notes, shiftStartStr, shiftEndStr, isOnDutyStr;
-        int shiftStart = 0, shiftEnd = 0;
-        bool isOnDuty = false;
-        
-        if (pos4 != string::npos) {
-            // New format with scheduling fields
-            notes = line.substr(pos3 + 1, pos4 - pos3 - 1);
-            shiftStartStr = line.substr(pos4 + 1, pos5 - pos4 - 1);
-            shiftEndStr = line.substr(pos5 + 1, pos6 - pos5 - 1);
-            isOnDutyStr = line.substr(pos6 + 1);
-            
-            try {
-                shiftStart = stoi(shiftStartStr);
-                shiftEnd = stoi(shiftEndStr);
-                isOnDuty = (stoi(isOnDutyStr) != 0);
-            } catch (...) {
-                shiftStart = 0;
-                shiftEnd = 0;
-                isOnDuty = false;
-            }
-        } else {
-            // Old format without scheduling fields
-            notes = line.substr(pos3 + 1);
-        }
-        
-        Record r{ id, vehicle, driver, notes, shiftStart, shiftEnd, isOnDuty };
-        Node* node = new Node(r);
-        if (!tail) {
-            node->next = node;
-            tail = node;
-        } else {
-            node->next = tail->next; // head
-            tail->next = node;
-            tail = node;
-        }
-        nextId = max(nextId, id + 1); // Update nextId
+        if (!RecordLayout::parseCsv(line, r)) continue;
+        appendNode(r); // Also updates nextId
     }
-    file.close();
-    cout << "Loaded " << filename << " successfully." << endl;
+    Log::status() << "Loaded " << filename << " successfully.\n";
+    return true;
+}
+
+// BINARY SNAPSHOT (data/ambulances.bin)
+// Columns from RecordLayout: ints {id, shiftStart, shiftEnd, isOnDuty}, strings {vehicle, driver, notes};
+// rotation order from head.
+bool Ambulance::saveToBinary(const string& filename) const {
+    Metrics::Timer timer(Metrics::SAVE_AMBULANCES_BIN);
+    BinarySnapshot::Writer snap(BinarySnapshot::AMBULANCES, RecordLayout::INT_COLUMNS, RecordLayout::STR_COLUMNS);
+    if (tail) {
+        Node* cur = tail->next; // head
+        do {
+            RecordLayout::addTo(snap, cur->data);
+            cur = cur->next;
+        } while (cur != tail->next);
+    }
+    return snap.writeTo(filename);
+}
+
+bool Ambulance::loadFromBinary(const string& filename) {
+    Metrics::Timer timer(Metrics::LOAD_AMBULANCES_BIN);
+    BinarySnapshot::Reader snap;
+    if (!snap.open(filename, BinarySnapshot::AMBULANCES, RecordLayout::INT_COLUMNS, RecordLayout::STR_COLUMNS)) {
+        return false;
+    }
+    clearAll();
+    Record r;
+    for (uint32_t i = 0; i < snap.count(); ++i) {
+        RecordLayout::readFrom(snap, i, r);
+        appendNode(r); // Also updates nextId
+    }
+    Log::status() << "Loaded " << filename << " successfully.\n";
     return true;
 }
 
 // SCHEDULING METHODS
 
-int Ambulance::timeToMinutes(const string& time) {
+int Ambulance::timeToMinutes(const string& time, bool endOfDay) {
     // Convert "HH:MM" format to minutes since midnight
-    // Example: "08:30" -> 510 minutes
+    // Example: "08:30" -> 510 minutes; "24:00" -> 1440 only as a shift end (endOfDay)
     try {
         size_t colonPos = time.find(':');
         if (colonPos == string::npos) return -1;
@@ -318,6 +454,7 @@ int Ambulance::timeToMinutes(const string& time) {
         int hours = stoi(time.substr(0, colonPos));
         int minutes = stoi(time.substr(colonPos + 1));
         
+        if (endOfDay && hours == 24 && minutes == 0) return 1440;
         if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59) {
             return -1;
         }
@@ -341,134 +478,127 @@ string Ambulance::minutesToTime(int minutes) {
 }
 
 bool Ambulance::assignShift(int ambulanceId, int shiftStart, int shiftEnd) {
+    Metrics::Timer timer(Metrics::ASSIGN_SHIFT);
     // SCHEDULING: Assign shift times to an ambulance
     // Parameters: ambulanceId, shiftStart (minutes since midnight), shiftEnd (minutes since midnight)
-    // Validation: ensure start < end, both are valid times (0-1440)
+    // Validation: start 0-1439, end 0-1440, start != end; an end before the start is an overnight
+    // shift (e.g. 22:00-06:00), which the interval index and the duty clock split at midnight.
     
-    if (shiftStart < 0 || shiftEnd <= shiftStart || shiftEnd > 1440) {
-        cout << "Invalid shift times. Start must be before end, and within 0-1440 minutes." << endl;
+    if (shiftStart < 0 || shiftStart >= 1440 || shiftEnd < 0 || shiftEnd > 1440 || shiftEnd == shiftStart) {
+        Log::error() << "Invalid shift times. Start and end must differ (end before start = overnight), "
+                     << "start within 00:00-23:59 and end within 00:00-24:00.\n";
         return false;
     }
     
     if (!tail) {
-        cout << "No ambulances registered." << endl;
+        Log::error() << "No ambulances registered.\n";
         return false;
     }
     
-    Node* cur = tail->next; // head
-    do {
-        if (cur->data.id == ambulanceId) {
-            cur->data.shiftStart = shiftStart;
-            cur->data.shiftEnd = shiftEnd;
-            cout << "Assigned shift to ambulance ID " << ambulanceId << ": "
-                 << minutesToTime(shiftStart) << " - " << minutesToTime(shiftEnd) << endl;
-            saveToFile();
-            return true;
-        }
-        cur = cur->next;
-    } while (cur != tail->next);
+    Node* node = findById(ambulanceId); // O(1) index lookup
+    if (node) {
+        setShift(node, shiftStart, shiftEnd);
+        Log::result() << "Assigned shift to ambulance ID " << ambulanceId << ": "
+             << minutesToTime(shiftStart) << " - " << minutesToTime(shiftEnd) << "\n";
+        logOperation("S," + to_string(ambulanceId) + "," + to_string(shiftStart) + "," + to_string(shiftEnd));
+        return true;
+    }
     
-    cout << "Ambulance ID " << ambulanceId << " not found." << endl;
+    Log::error() << "Ambulance ID " << ambulanceId << " not found.\n";
     return false;
 }
 
 void Ambulance::updateDutyStatus() {
-    // Update on-duty status for all ambulances based on current system time
-    time_t now = time(nullptr);
-    struct tm* timeinfo = localtime(&now);
-    int currentMinutes = timeinfo->tm_hour * 60 + timeinfo->tm_min;
-    
-    if (!tail) return;
-    
-    Node* cur = tail->next;
-    do {
-        // Check if current time falls within shift window
-        if (cur->data.shiftStart == 0 && cur->data.shiftEnd == 0) {
-            // No shift assigned
-            cur->data.isOnDuty = false;
-        } else if (cur->data.shiftStart < cur->data.shiftEnd) {
-            // Normal case: start < end (e.g., 8:00 AM - 4:00 PM)
-            cur->data.isOnDuty = (currentMinutes >= cur->data.shiftStart && currentMinutes < cur->data.shiftEnd);
-        } else {
-            // Overnight shift: start > end (e.g., 10:00 PM - 6:00 AM) - not typical, kept for robustness
-            cur->data.isOnDuty = (currentMinutes >= cur->data.shiftStart || currentMinutes < cur->data.shiftEnd);
-        }
-        cur = cur->next;
-    } while (cur != tail->next);
+    // Duty flags are maintained by boundary events; this only fires the ones that are due.
+    tick();
+}
+
+void Ambulance::tick() {
+    Metrics::Timer timer(Metrics::UPDATE_DUTY_STATUS);
+    duty.advance(DutyClock::wallClock());
+}
+
+int Ambulance::subscribeDutyChanges(DutyClock::Listener listener) {
+    return duty.subscribe(std::move(listener));
+}
+
+void Ambulance::unsubscribeDutyChanges(int token) {
+    duty.unsubscribe(token);
+}
+
+vector<int> Ambulance::onDutyAt(int minute) const {
+    vector<int> ids;
+    shifts.onDutyAt(minute, ids);
+    return ids;
+}
+
+const Ambulance::Record* Ambulance::recordOf(int id) const {
+    Node* node = findById(id);
+    return node ? &node->data : nullptr;
 }
 
 bool Ambulance::isAmbulanceOnDuty(int ambulanceId) const {
-    if (!tail) return false;
-    
-    Node* cur = tail->next;
-    do {
-        if (cur->data.id == ambulanceId) {
-            return cur->data.isOnDuty;
-        }
-        cur = cur->next;
-    } while (cur != tail->next);
-    
-    return false;
+    Node* node = findById(ambulanceId); // O(1) index lookup
+    return node && node->data.isOnDuty;
 }
 
 void Ambulance::displayOnDutyAmbulances() const {
     // Display all currently on-duty ambulances (filtered view)
     if (!tail) {
-        cout << "No ambulances registered." << endl;
+        cout << "No ambulances registered.\n";
         return;
     }
-    
-    cout << "\n[ CURRENTLY ON-DUTY AMBULANCES ]" << endl;
-    cout << left << setw(6) << "ID" << setw(14) << "Vehicle" << setw(18) << "Driver" 
-         << setw(14) << "Shift" << "Notes" << endl;
-    cout << string(85, '-') << endl;
-    
-    bool foundAny = false;
-    Node* cur = tail->next;
-    do {
-        const Record& r = cur->data;
-        if (r.isOnDuty) {
-            string shiftTime = minutesToTime(r.shiftStart) + "-" + minutesToTime(r.shiftEnd);
-            cout << left << setw(6) << r.id << setw(14) << r.vehicleReg << setw(18) << r.driverName 
-                 << setw(14) << shiftTime << r.notes << endl;
-            foundAny = true;
+    int minute = DutyClock::wallClock().minuteOfDay;
+    PagedView::browse([this, minute](int offset, int limit) { return displayOnDuty(minute, offset, limit); });
+}
+
+bool Ambulance::displayOnDuty(int minute, int offset, int limit) const {
+    // Stabbing query on the interval index, consumed one ID at a time: O(log n + offset + limit)
+    ostream& out = Log::result();
+    ShiftIndex::Cursor cursor(shifts, minute);
+    int id;
+    bool more = true;
+    for (int i = 0; i < offset && (more = cursor.next(id)); ++i) {}
+    if (more) more = cursor.next(id);
+    if (!more) {
+        if (offset == 0) out << "No ambulances on duty at " << minutesToTime(minute) << ".\n";
+        else PagedView::footer(out, offset, 0, -1, false);
+        return false;
+    }
+
+    out << "\n[ ON-DUTY AMBULANCES AT " << minutesToTime(minute) << " ]\n";
+    out << left << setw(6) << "ID" << setw(14) << "Vehicle" << setw(18) << "Driver" 
+        << setw(14) << "Shift" << "Notes\n";
+    out << string(85, '-') << "\n";
+    int shown = 0;
+    while (more && shown < limit) {
+        if (const Record* r = recordOf(id)) {
+            string shiftTime = minutesToTime(r->shiftStart) + "-" + minutesToTime(r->shiftEnd);
+            out << left << setw(6) << r->id << setw(14) << r->vehicleReg << setw(18) << r->driverName 
+                << setw(14) << shiftTime << r->notes << "\n";
+            shown++;
         }
-        cur = cur->next;
-    } while (cur != tail->next);
-    
-    if (!foundAny) {
-        cout << "No ambulances currently on duty." << endl;
+        more = cursor.next(id);
     }
+    PagedView::footer(out, offset, shown, -1, more);
+    return more;
 }
 
 void Ambulance::displayScheduleByTime() const {
     // Display ambulances sorted by shift start time (optional filtered view)
     if (!tail) {
-        cout << "No ambulances registered." << endl;
+        cout << "No ambulances registered.\n";
         return;
     }
     
-    cout << "\n[ AMBULANCE SCHEDULE (Sorted by Shift Time) ]" << endl;
+    cout << "\n[ AMBULANCE SCHEDULE (Sorted by Shift Time) ]\n";
     cout << left << setw(6) << "ID" << setw(14) << "Vehicle" << setw(18) << "Driver" 
-         << setw(14) << "Shift" << setw(10) << "On-Duty" << "Notes" << endl;
-    cout << string(95, '-') << endl;
-    
-    // Collect all ambulances into a temporary vector for sorting
-    vector<Node*> ambulances;
-    Node* cur = tail->next;
-    do {
-        ambulances.push_back(cur);
-        cur = cur->next;
-    } while (cur != tail->next);
-    
-    // Sort by shiftStart time
-    sort(ambulances.begin(), ambulances.end(), [](Node* a, Node* b) {
-        return a->data.shiftStart < b->data.shiftStart;
-    });
+         << setw(14) << "Shift" << setw(10) << "On-Duty" << "Notes\n";
+    cout << string(95, '-') << "\n";
     
-    // Display sorted ambulances
-    for (Node* node : ambulances) {
-        const Record& r = node->data;
+    // byStart is kept ordered by shiftStart on every register/assign/remove: no copy, no sort
+    for (const auto& entry : byStart) {
+        const Record& r = entry.second->data;
         string shiftTime;
         if (r.shiftStart == 0 && r.shiftEnd == 0) {
             shiftTime = "Not assigned";
@@ -477,13 +607,14 @@ void Ambulance::displayScheduleByTime() const {
         }
         string onDutyStr = r.isOnDuty ? "Yes" : "No";
         cout << left << setw(6) << r.id << setw(14) << r.vehicleReg << setw(18) << r.driverName 
-             << setw(14) << shiftTime << setw(10) << onDutyStr << r.notes << endl;
+             << setw(14) << shiftTime << setw(10) << onDutyStr << r.notes << "\n";
     }
 }
 
 void Ambulance::displayMenu() {
     int choice;
     do {
+        tick(); // Apply shift boundaries passed while the menu was waiting for input
         cout << "\n====== AMBULANCE DISPATCH MENU ======\n"
              << "1. Register Ambulance\n"
              << "2. Rotate Ambulance Shift (Fair Rotation)\n"
@@ -491,6 +622,7 @@ void Ambulance::displayMenu() {
              << "4. Assign Shift Time to Ambulance\n"
              << "5. Update On-Duty Status (Current Time)\n"
              << "6. Remove Ambulance by ID\n"
+             << "7. View Units On Duty Now\n"
              << "0. Back to Main Menu\n"
              << "------------------------------------\n"
              << "Enter your choice: ";		cin >> choice;
@@ -502,43 +634,43 @@ void Ambulance::displayMenu() {
 
 		switch (choice) {
 			case 1:
-				cout << "\n[ Registering Ambulance ]" << endl;
+				cout << "\n[ Registering Ambulance ]\n";
 				registerAmbulance();
 				break;
 			case 2:
-				cout << "\n[ Rotating Ambulance Shift ]" << endl;
+				cout << "\n[ Rotating Ambulance Shift ]\n";
 				rotateShift();
 				break;
 			case 3:
-				cout << "\n[ Full Ambulance Schedule ]" << endl;
+				cout << "\n[ Full Ambulance Schedule ]\n";
 				updateDutyStatus();
 				displaySchedule();
 				break;
 			case 4: {
-				cout << "\n[ Assigning Shift ]" << endl;
+				cout << "\n[ Assigning Shift ]\n";
 				int id;
 				string startStr, endStr;
 				cout << "Enter ambulance ID: ";
 				cin >> id;
 				cout << "Enter shift start time (HH:MM, e.g., 08:30): ";
 				cin >> startStr;
-				cout << "Enter shift end time (HH:MM, e.g., 16:30): ";
+				cout << "Enter shift end time (HH:MM, e.g., 16:30; earlier than start = overnight, 24:00 = midnight): ";
 				cin >> endStr;
 				
 				int startMin = timeToMinutes(startStr);
-				int endMin = timeToMinutes(endStr);
+				int endMin = timeToMinutes(endStr, true);
 				
 				if (startMin == -1 || endMin == -1) {
-					cout << "Invalid time format. Please use HH:MM (24-hour format)." << endl;
+					cout << "Invalid time format. Please use HH:MM (24-hour format).\n";
 				} else {
 					assignShift(id, startMin, endMin);
 				}
 				break;
 			}
 			case 5: {
-				cout << "\n[ Updating Duty Status ]" << endl;
+				cout << "\n[ Updating Duty Status ]\n";
 				updateDutyStatus();
-				cout << "Duty status updated based on current system time." << endl;
+				cout << "Duty status updated based on current system time.\n";
 				break;
 			}
 			case 6: {
@@ -549,15 +681,19 @@ void Ambulance::displayMenu() {
 				else {
 					cin.clear();
 					cin.ignore(numeric_limits<streamsize>::max(), '\n');
-					cout << "Invalid ID input." << endl;
+					cout << "Invalid ID input.\n";
 				}
 				break;
 			}
+			case 7:
+				cout << "\n[ Units On Duty Now ]\n";
+				displayOnDutyAmbulances();
+				break;
 			case 0:
-				cout << "Returning to main menu..." << endl;
+				cout << "Returning to main menu...\n";
 				break;
 			default:
-				cout << "Invalid choice. Please try again." << endl;
+				cout << "Invalid choice. Please try again.\n";
 		}
 
 	} while (choice != 0);
@@ -3,6 +3,15 @@
 #define AMBULANCE_HPP
 
 #include <string>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Journal.hpp"
+#include "DutyClock.hpp"
+#include "NodePool.hpp"
+#include "RecordSchema.hpp"
+#include "ShiftIndex.hpp"
 
 class Ambulance {
 public:
@@ -11,30 +20,46 @@ public:
 		std::string vehicleReg;
 		std::string driverName;
 		std::string notes;
-		// Scheduling fields (minutes since midnight: 0-1439)
+		// Scheduling fields (minutes since midnight: start 0-1439, end 0-1440; 0-0 = not assigned)
 		int shiftStart; // start time (e.g., 480 = 8:00 AM)
 		int shiftEnd;   // end time (e.g., 960 = 4:00 PM)
 		bool isOnDuty;  // current duty status
 	};
 
+	// Storage layout (ambulances.txt rows, R journal entries, ambulances.bin):
+	// ID,Vehicle,Driver,Notes[,ShiftStart,ShiftEnd,IsOnDuty] — rows from before scheduling end after
+	// Notes and load unassigned / off duty. Notes with commas are written quoted.
+	typedef RecordSchema::Layout<Record,
+	                             RecordSchema::Field<&Record::id>,
+	                             RecordSchema::Field<&Record::vehicleReg>,
+	                             RecordSchema::Field<&Record::driverName>,
+	                             RecordSchema::Field<&Record::notes>,
+	                             RecordSchema::Field<&Record::shiftStart, RecordSchema::OPTIONAL>,
+	                             RecordSchema::Field<&Record::shiftEnd, RecordSchema::OPTIONAL>,
+	                             RecordSchema::Field<&Record::isOnDuty, RecordSchema::OPTIONAL>> RecordLayout;
+
 	Ambulance();
 	~Ambulance();
 
 	// Register a new ambulance. Returns true on success, false if duplicate or invalid.
 	bool registerAmbulance();
+	bool registerAmbulance(const std::string& reg, const std::string& driver, const std::string& notes); // No prompts
 
 	// Rotate the schedule so next ambulance becomes head/takes duty.
 	bool rotateShift();
 
-	// Display the current rotation/order starting from current head.
+	// Display the current rotation/order starting from current head, one page at a time.
 	void displaySchedule() const;
+	bool displaySchedule(int offset, int limit) const; // One page in rotation order; true if more follow
 
 	// SCHEDULING METHODS
-	// Assign a shift to an ambulance (start time and end time in minutes since midnight)
+	// Assign a shift to an ambulance (start time and end time in minutes since midnight;
+	// end < start is an overnight shift, e.g. 22:00-06:00)
 	bool assignShift(int ambulanceId, int shiftStart, int shiftEnd);
 
-	// Get current on-duty ambulances
+	// Get current on-duty ambulances (paged; walks the interval index, not the roster)
 	void displayOnDutyAmbulances() const;
+	bool displayOnDuty(int minute, int offset, int limit) const; // One page of units on shift at minute
 
 	// Display schedule sorted by shift time
 	void displayScheduleByTime() const;
@@ -42,11 +67,23 @@ public:
 	// Check if ambulance is currently on duty (based on current system time)
 	bool isAmbulanceOnDuty(int ambulanceId) const;
 
-	// Update on-duty status for all ambulances based on current time
+	// IDs of ambulances whose shift covers minute (0-1439): O(log n + k) via the interval index
+	std::vector<int> onDutyAt(int minute) const;
+
+	// Read-only view of one unit (nullptr if unknown): O(1) via the ID index
+	const Record* recordOf(int id) const;
+
+	// Duty events: tick() fires every shift boundary that has passed (flipping isOnDuty);
+	// subscribers are told about each change (id, onDuty). Returns a token for unsubscribe.
+	void tick();
+	int subscribeDutyChanges(DutyClock::Listener listener);
+	void unsubscribeDutyChanges(int token);
+
+	// Bring on-duty status up to the current time (fires due duty events; no roster scan)
 	void updateDutyStatus();
 
 	// Helper: convert time string (HH:MM) to minutes since midnight
-	static int timeToMinutes(const std::string& time);
+	static int timeToMinutes(const std::string& time, bool endOfDay = false); // endOfDay: also "24:00" (1440)
 
 	// Helper: convert minutes since midnight to time string (HH:MM)
 	static std::string minutesToTime(int minutes);
@@ -57,17 +94,43 @@ public:
 	// Load ambulances from file (clears current list first)
 	bool loadFromFile(const std::string& filename = "data/ambulances.txt");
 
+	// Binary snapshot (data/ambulances.bin), written on compaction and preferred at startup when current
+	bool saveToBinary(const std::string& filename) const;
+	bool loadFromBinary(const std::string& filename);
+
 	// Menu driven interface (mirrors PatientAdmission style)
 	void displayMenu();
 
 	// Optional: remove ambulance by id
 	bool removeAmbulance(int id);
+
+private:
 	// Hide implementation details in .cpp
 	struct Node;
 	Node* tail; // nullptr when empty; tail->next is head
 	int nextId;
+	// Side index kept in sync by appendNode/unlinkNode/clearAll (O(1) lookups; rotation untouched)
+	std::unordered_map<int, Node*> byId;
+	std::unordered_map<std::string, Node*> byReg;
+	Node* findById(int id) const;
+	NodePool<Node> pool; // Node storage: contiguous blocks, O(1) create/destroy, bulk reset
 	// Helper to free list
 	void clearAll();
+
+	// Append-only operation log (data/ambulances.log): one entry per register/assign/remove,
+	// folded back into ambulances.txt on compaction instead of rewriting the file every time.
+	Journal journal;
+	void logOperation(const std::string& entry);
+	void applyJournalEntry(std::string_view entry); // Idempotent replay of one entry
+	void compact();
+	void appendNode(const Record& r);                 // O(1) insert at tail
+	bool unlinkNode(int id);                          // Remove + free, no I/O
+
+	// Shift indexes, kept in sync with the list like byId/byReg
+	ShiftIndex shifts;                    // Interval tree: on-duty stabbing queries
+	std::multimap<int, Node*> byStart;    // shiftStart order for displayScheduleByTime (no per-call sort)
+	DutyClock duty;                       // Min-heap of upcoming shift boundaries
+	void setShift(Node* node, int shiftStart, int shiftEnd);
 };
 
 #endif // AMBULANCE_HPP
@@ -0,0 +1,381 @@
+// BatchMode.cpp
+// Implementation of the headless command runner (see BatchMode.hpp).
+// Complexity: one pass over the script; each command costs what the module operation costs.
+
+#include "BatchMode.hpp"
+#include "CsvTokenizer.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "PagedView.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Comma-separated arguments, trimmed. With a limit, everything after the (limit-1)th comma is kept
+// whole as the last argument (notes may contain commas).
+vector<string> splitArgs(string_view args, size_t limit = 0) {
+    vector<string> out;
+    args = trimView(args);
+    if (args.empty()) return out;
+    CsvTokenizer tok(args);
+    string_view field;
+    while (!tok.done()) {
+        if (limit && out.size() + 1 == limit) {
+            out.emplace_back(trimView(tok.rest()));
+            break;
+        }
+        tok.next(field);
+        out.emplace_back(trimView(field));
+    }
+    return out;
+}
+
+bool parseCount(const vector<string>& a, size_t i, int& out) {
+    return i < a.size() && parseIntField(a[i], out);
+}
+
+// Optional page window starting at a[i]: "<limit>[,<offset>]" (defaults: one page from the top).
+bool parseWindow(const vector<string>& a, size_t i, int& limit, int& offset) {
+    limit = PagedView::PAGE_SIZE;
+    offset = 0;
+    if (a.size() > i + 2) return false;
+    if (a.size() > i && (!parseCount(a, i, limit) || limit <= 0)) return false;
+    if (a.size() > i + 1 && (!parseCount(a, i + 1, offset) || offset < 0)) return false;
+    return true;
+}
+
+// Optional repeat count ("discharge 5"); defaults to 1.
+bool parseRepeat(const vector<string>& a, int& n) {
+    n = 1;
+    if (a.empty()) return true;
+    return parseCount(a, 0, n) && n > 0;
+}
+
+} // namespace
+
+CommandTarget commandTarget(const string& name, CommandAccess& access) {
+    typedef CommandTarget T;
+    typedef CommandAccess A;
+    static const struct { const char* name; CommandTarget target; CommandAccess access; } table[] = {
+        { "admit", T::PATIENTS, A::WRITE },           { "discharge", T::PATIENTS, A::WRITE },
+        { "find-patient", T::PATIENTS, A::READ },     { "queue", T::PATIENTS, A::READ },
+        { "add-supply", T::SUPPLIES, A::WRITE },      { "consume", T::SUPPLIES, A::WRITE },
+        { "consume-id", T::SUPPLIES, A::WRITE },      { "stock", T::SUPPLIES, A::READ },
+        { "supplies", T::SUPPLIES, A::READ },         { "expiring", T::SUPPLIES, A::READ },
+        { "log-emergency", T::EMERGENCY, A::WRITE },  { "process", T::EMERGENCY, A::WRITE },
+        { "update-priority", T::EMERGENCY, A::WRITE }, { "pending", T::EMERGENCY, A::READ },
+        { "submit-emergency", T::EMERGENCY, A::INTAKE }, { "intake-stats", T::EMERGENCY, A::READ },
+        { "import-patients", T::EMERGENCY, A::WRITE }, { "set-aging", T::EMERGENCY, A::WRITE },
+        { "wait-report", T::EMERGENCY, A::READ },
+        { "register", T::AMBULANCES, A::WRITE },      { "assign-shift", T::AMBULANCES, A::WRITE },
+        { "rotate", T::AMBULANCES, A::WRITE },        { "remove-ambulance", T::AMBULANCES, A::WRITE },
+        { "on-duty", T::AMBULANCES, A::READ },        { "schedule", T::AMBULANCES, A::READ },
+        { "metrics", T::UNKNOWN, A::READ },          // Lock-free: reads atomics only
+        { "dispatch", T::EMERGENCY, A::DISPATCH },   { "unit-returning", T::AMBULANCES, A::WRITE },
+        { "unit-available", T::AMBULANCES, A::WRITE }, { "fleet-status", T::AMBULANCES, A::READ },
+    };
+    for (const auto& entry : table) {
+        if (name == entry.name) {
+            access = entry.access;
+            return entry.target;
+        }
+    }
+    access = A::READ;
+    return T::UNKNOWN;
+}
+
+bool parseCommandLine(string_view text, int line, Command& out) {
+    text = trimView(text);
+    if (text.empty() || text[0] == '#') return false;
+    size_t cut = text.find_first_of(" \t");
+    out.line = line;
+    out.name.assign(text.substr(0, cut));
+    if (cut == string_view::npos) out.args.clear();
+    else out.args.assign(text.substr(cut + 1));
+    return true;
+}
+
+bool runCommand(const Command& command, HospitalModules& m, string& error) {
+    const string& cmd = command.name;
+    string_view rawArgs = command.args;
+    if (cmd == "admit") {
+        vector<string> a = splitArgs(rawArgs, 2);
+        if (a.size() != 2) { error = "usage: admit <name>,<condition>"; return false; }
+        int id = m.pa.admit(a[0], a[1]);
+        if (id < 0) return false;
+        Log::result() << "Admitted patient ID " << id << ".\n";
+        return true;
+    }
+    if (cmd == "discharge") {
+        int n;
+        if (!parseRepeat(splitArgs(rawArgs), n)) { error = "usage: discharge [n]"; return false; }
+        return n == 1 ? m.pa.dischargePatient() : m.pa.dischargeN(n) > 0;
+    }
+    if (cmd == "log-emergency") {
+        vector<string> a = splitArgs(rawArgs);
+        int priority = 0;
+        if (a.size() < 2 || a.size() > 3 || (a.size() == 3 && !parseCount(a, 2, priority))) {
+            error = "usage: log-emergency <name>,<type>[,<priority>]";
+            return false;
+        }
+        int id = m.em.logCase(a[0], a[1], priority);
+        if (id < 0) { error = "needs a priority 1-10 (or a built-in type)"; return false; }
+        Log::result() << "[+] Emergency case " << id << " logged.\n";
+        return true;
+    }
+    if (cmd == "submit-emergency") {
+        vector<string> a = splitArgs(rawArgs);
+        EmergencyCase c;
+        c.patientID = 0;
+        c.priority = 0;
+        if (a.size() < 2 || a.size() > 3 || (a.size() == 3 && !parseCount(a, 2, c.priority))) {
+            error = "usage: submit-emergency <name>,<type>[,<priority>]";
+            return false;
+        }
+        c.patientName = a[0];
+        c.emergencyType = a[1];
+        if (!m.em.submitCase(std::move(c))) { error = "needs a priority 1-10 (or a built-in type)"; return false; }
+        Log::result() << "[+] Emergency case queued for triage.\n";
+        return true;
+    }
+    if (cmd == "import-patients") {
+        m.em.loadPatientsFromFile();
+        return true;
+    }
+    if (cmd == "set-aging") {
+        vector<string> a = splitArgs(rawArgs);
+        AgingPolicy policy;
+        if (a.size() != 1 || !parseCount(a, 0, policy.secondsPerLevel) || policy.secondsPerLevel < 0) {
+            error = "usage: set-aging <seconds per level, 0 = off>";
+            return false;
+        }
+        return m.em.setAgingPolicy(policy);
+    }
+    if (cmd == "process") {
+        int n;
+        if (!parseRepeat(splitArgs(rawArgs), n)) { error = "usage: process [n]"; return false; }
+        if (m.em.pendingCount() == 0) { error = "no pending cases"; return false; }
+        for (int i = 0; i < n && m.em.pendingCount() > 0; ++i) m.em.processCriticalCase();
+        return true;
+    }
+    if (cmd == "update-priority") {
+        vector<string> a = splitArgs(rawArgs);
+        int id, priority;
+        if (a.size() != 2 || !parseCount(a, 0, id) || !parseCount(a, 1, priority)) {
+            error = "usage: update-priority <id>,<priority>";
+            return false;
+        }
+        if (!m.em.setPriority(id, priority)) { error = "no pending case with that ID (or priority not 1-10)"; return false; }
+        Log::result() << "[✓] Priority of case " << id << " set to " << priority << ".\n";
+        return true;
+    }
+    if (cmd == "add-supply") {
+        vector<string> a = splitArgs(rawArgs, 5);
+        MedicalSupply::Supply s;
+        if (a.size() < 4 || !parseCount(a, 1, s.quantity)) {
+            error = "usage: add-supply <name>,<qty>,<batch>,<expiry>[,<notes>]";
+            return false;
+        }
+        s.id = 0;
+        s.name = a[0];
+        s.batch = a[2];
+        s.expiry = a[3];
+        if (a.size() == 5) s.notes = a[4];
+        return m.ms.addSupply(s);
+    }
+    if (cmd == "consume" || cmd == "consume-id") {
+        vector<string> a = splitArgs(rawArgs);
+        int qty, id;
+        if (a.size() != 2 || !parseCount(a, 1, qty) || (cmd == "consume-id" && !parseCount(a, 0, id))) {
+            error = "usage: " + cmd + (cmd == "consume" ? " <name>,<qty>" : " <id>,<qty>");
+            return false;
+        }
+        return cmd == "consume" ? m.ms.consume(a[0], qty) : m.ms.consume(id, qty);
+    }
+    if (cmd == "register") {
+        vector<string> a = splitArgs(rawArgs, 3);
+        if (a.size() < 2) { error = "usage: register <reg>,<driver>[,<notes>]"; return false; }
+        return m.ad.registerAmbulance(a[0], a[1], a.size() == 3 ? a[2] : string());
+    }
+    if (cmd == "assign-shift") {
+        vector<string> a = splitArgs(rawArgs);
+        int id;
+        if (a.size() != 3 || !parseCount(a, 0, id)) { error = "usage: assign-shift <id>,<HH:MM>,<HH:MM>"; return false; }
+        int start = Ambulance::timeToMinutes(a[1]);
+        int end = Ambulance::timeToMinutes(a[2], true);   // 24:00 allowed (00:00-24:00 = all day)
+        if (start < 0 || end < 0) { error = "times must be HH:MM"; return false; }
+        return m.ad.assignShift(id, start, end);
+    }
+    if (cmd == "rotate") {
+        return m.ad.rotateShift();
+    }
+    if (cmd == "remove-ambulance") {
+        vector<string> a = splitArgs(rawArgs);
+        int id;
+        if (a.size() != 1 || !parseCount(a, 0, id)) { error = "usage: remove-ambulance <id>"; return false; }
+        return m.ad.removeAmbulance(id);
+    }
+    if (cmd == "dispatch" || cmd == "fleet-status") {
+        vector<string> a = splitArgs(rawArgs);
+        int minute = a.empty() ? DutyClock::wallClock().minuteOfDay : Ambulance::timeToMinutes(a[0]);
+        if (a.size() > 1 || minute < 0) { error = "usage: " + cmd + " [HH:MM]"; return false; }
+        if (cmd == "fleet-status") {
+            m.dispatch.displayFleetStatus(minute);
+            return true;
+        }
+        DispatchEngine::Assignment assigned;
+        return m.dispatch.dispatchNext(minute, assigned, error);
+    }
+    if (cmd == "unit-returning" || cmd == "unit-available") {
+        vector<string> a = splitArgs(rawArgs);
+        int id;
+        if (a.size() != 1 || !parseCount(a, 0, id)) { error = "usage: " + cmd + " <id>"; return false; }
+        return cmd == "unit-returning" ? m.dispatch.markReturning(id) : m.dispatch.markAvailable(id);
+    }
+    if (cmd == "find-patient") {
+        vector<string> a = splitArgs(rawArgs);
+        int id;
+        if (a.size() != 1 || !parseCount(a, 0, id)) { error = "usage: find-patient <id>"; return false; }
+        return m.pa.searchPatientById(id);
+    }
+    if (cmd == "queue") {
+        int limit, offset;
+        if (!parseWindow(splitArgs(rawArgs), 0, limit, offset)) { error = "usage: queue [limit[,offset]]"; return false; }
+        m.pa.viewPatientQueue(offset, limit);
+        return true;
+    }
+    if (cmd == "pending") {
+        vector<string> a = splitArgs(rawArgs);
+        int limit, offset;
+        if (!parseWindow(a, 0, limit, offset)) { error = "usage: pending [limit[,offset]]"; return false; }
+        Log::result() << "Pending emergency cases: " << m.em.pendingCount() << "\n";
+        if (!a.empty()) m.em.viewPendingCases(offset, limit);   // Top cases in triage order
+        return true;
+    }
+    if (cmd == "intake-stats") {
+        Log::result() << "Intake queue: " << m.em.intakeDepth() << " waiting; submit->heap wait p50 "
+                      << m.em.intakeWaitUs(50) << " us, p99 " << m.em.intakeWaitUs(99) << " us\n";
+        return true;
+    }
+    if (cmd == "metrics") {
+        string path(trimView(rawArgs));
+        if (path.empty()) {
+            Metrics::writeSummary(Log::result());
+            return true;
+        }
+        if (!Metrics::writeSnapshot(path)) { error = "cannot write " + path; return false; }
+        Log::result() << "Metrics written to " << path << ".\n";
+        return true;
+    }
+    if (cmd == "wait-report") {
+        m.em.viewWaitTimes();
+        return true;
+    }
+    if (cmd == "stock") {
+        string name(trimView(rawArgs));
+        if (name.empty()) { error = "usage: stock <name>"; return false; }
+        Log::result() << "Total quantity of '" << name << "': " << m.ms.totalQuantity(name) << " units\n";
+        return true;
+    }
+    if (cmd == "supplies") {
+        int limit, offset;
+        if (!parseWindow(splitArgs(rawArgs), 0, limit, offset)) { error = "usage: supplies [limit[,offset]]"; return false; }
+        m.ms.viewCurrentSupplies(offset, limit);
+        return true;
+    }
+    if (cmd == "expiring") {
+        vector<string> a = splitArgs(rawArgs);
+        int days = 7, limit, offset;   // Default: this week
+        if ((!a.empty() && (!parseCount(a, 0, days) || days < 0 || days > 36500)) ||
+            !parseWindow(a, a.empty() ? 0 : 1, limit, offset)) {
+            error = "usage: expiring [days[,limit[,offset]]]";
+            return false;
+        }
+        m.ms.viewExpiringSoon(days, offset, limit);
+        return true;
+    }
+    if (cmd == "schedule") {
+        int limit, offset;
+        if (!parseWindow(splitArgs(rawArgs), 0, limit, offset)) { error = "usage: schedule [limit[,offset]]"; return false; }
+        m.ad.displaySchedule(offset, limit);
+        return true;
+    }
+    if (cmd == "on-duty") {
+        vector<string> a = splitArgs(rawArgs);
+        int minute = a.empty() ? DutyClock::wallClock().minuteOfDay : Ambulance::timeToMinutes(a[0]);
+        int limit, offset;
+        if (minute < 0 || !parseWindow(a, 1, limit, offset)) {
+            error = "usage: on-duty [HH:MM[,limit[,offset]]]";
+            return false;
+        }
+        if (a.size() > 1) {   // With a window: one page of the full table
+            m.ad.displayOnDuty(minute, offset, limit);
+            return true;
+        }
+        vector<int> ids = m.ad.onDutyAt(minute);
+        ostream& out = Log::result();
+        out << "On duty at " << Ambulance::minutesToTime(minute) << ":";
+        for (int id : ids) out << " " << id;
+        out << (ids.empty() ? " none\n" : "\n");
+        return true;
+    }
+    error = "unknown command '" + cmd + "'";
+    return false;
+}
+
+namespace {
+
+int runCommands(istream& in, HospitalModules& m) {
+    int lineNo = 0, ok = 0, failed = 0;
+    string line, error;
+    Command cmd;
+    while (getline(in, line)) {
+        if (!parseCommandLine(line, ++lineNo, cmd)) continue;
+
+        error.clear();
+        if (runCommand(cmd, m, error)) {
+            ++ok;
+            Log::result() << "[batch] line " << lineNo << ": " << cmd.name << " ok\n";
+        } else {
+            ++failed;
+            ostream& out = Log::error();
+            out << "[batch] line " << lineNo << ": " << cmd.name << " FAILED";
+            if (!error.empty()) out << " (" << error << ")";
+            out << "\n";
+        }
+    }
+    Log::error() << "[batch] " << ok << " ok, " << failed << " failed.\n";
+    return failed;
+}
+
+} // namespace
+
+int runBatch(const string& source) {
+    ifstream file;
+    istream* in = &cin;
+    if (source != "-") {
+        file.open(source);
+        if (!file) {
+            cerr << "Cannot open batch file '" << source << "'.\n";
+            return 2;
+        }
+        in = &file;
+    }
+
+    // All module output (load messages, results, final compaction) goes to one buffer.
+    ostringstream buffer;
+    streambuf* console = cout.rdbuf(buffer.rdbuf());
+    int failed;
+    {
+        HospitalModules m;
+        failed = runCommands(*in, m);
+    }   // Destructors compact here, still buffered
+    cout.rdbuf(console);
+    cout << buffer.str() << flush;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,79 @@
+// BatchMode.hpp
+// Headless command runner: drives the four roles from a script instead of the menus.
+// Usage: ./main --batch commands.txt     (or "--batch -" to read commands from stdin)
+// Why a separate mode?
+// - Scripts and integration tests were throttled by the displayMenu() round trip: every step
+//   printed a prompt, waited on cin and (for admissions) rendered a ticket.
+// - Here each line is one command that calls the modules' non-interactive entry points directly:
+//   no prompts, no tickets, no menu redraws.
+// - Everything the modules print is collected in memory (cout is redirected to a buffer) and
+//   written to the real stdout once, after the last command and the final compaction.
+// Format: one command per line, "<command> <comma-separated arguments>"; blank lines and lines
+// starting with '#' are skipped. The last argument of add-supply / register is free text.
+//   admit <name>,<condition>                 discharge [n]
+//   log-emergency <name>,<type>[,<priority>] process [n]         update-priority <id>,<priority>
+//   submit-emergency <name>,<type>[,<priority>]   (queued for triage; ID assigned when drained)
+//   import-patients      (resync triage from patients.txt; admissions normally arrive live)
+//   set-aging <seconds>  (seconds of waiting per priority level gained; 0 = strict priority)
+//   add-supply <name>,<qty>,<batch>,<expiry>[,<notes>]
+//   consume <name>,<qty>                     consume-id <id>,<qty>
+//   register <reg>,<driver>[,<notes>]        assign-shift <id>,<HH:MM>,<HH:MM> (end < start: overnight; end 24:00 ok)
+//   rotate                                   remove-ambulance <id>
+//   dispatch [HH:MM]     (most critical case -> best available unit; default: now)
+//   unit-returning <id>                      unit-available <id>
+// Read-only queries (shared lock in service mode):
+//   find-patient <id>    intake-stats    wait-report    stock <name>    fleet-status [HH:MM]
+//   metrics [<file>]     (latency table, or Prometheus-format snapshot file)
+// Paged views take an optional window "<limit>[,<offset>]" (default: first 20 rows):
+//   queue [window]   pending [window] (count only without one)   supplies [window]
+//   expiring [<days>[,window]]   schedule [window]   on-duty [HH:MM[,window]] (IDs only without one)
+// Each command reports "ok" or "FAILED" with its line number; the exit code is 1 if any failed.
+// Verbosity follows Log (see Log.hpp): main lowers the default to NORMAL for batch runs, so load/save
+// chatter is dropped unless --verbose is given; --quiet leaves only failures and the summary.
+
+#ifndef BATCH_MODE_HPP
+#define BATCH_MODE_HPP
+
+#include <string>
+#include <string_view>
+#include "PatientAdmission.hpp"
+#include "MedicalSupply.hpp"
+#include "Emergency.hpp"
+#include "Ambulance.hpp"
+#include "DispatchEngine.hpp"
+
+// The four roles, owned together (same construction order as the interactive main), plus the
+// dispatch engine that links Roles 3 and 4 (declared last: destroyed before the modules it uses).
+struct HospitalModules {
+    PatientAdmission pa;
+    MedicalSupply ms;
+    EmergencyDepartment em;
+    Ambulance ad;
+    DispatchEngine dispatch{em, ad};
+};
+
+// === Command layer (shared with ServiceCore) ===
+struct Command {
+    int line;                 // 1-based line number in its source
+    std::string name;
+    std::string args;         // Raw comma-separated arguments
+};
+
+// Which module a command touches, and how (drives ServiceCore's locking):
+// READ = shared lock, WRITE = exclusive lock, INTAKE = no lock (lock-free submission queue),
+// DISPATCH = exclusive on EMERGENCY and AMBULANCES together (the dispatch engine's state belongs to
+// the AMBULANCES module, so its other commands lock only that).
+enum class CommandTarget { PATIENTS = 0, SUPPLIES = 1, EMERGENCY = 2, AMBULANCES = 3, UNKNOWN = 4 };
+enum class CommandAccess { READ, WRITE, INTAKE, DISPATCH };
+CommandTarget commandTarget(const std::string& name, CommandAccess& access);
+
+// Split one script line. False for blank lines and comments.
+bool parseCommandLine(std::string_view text, int line, Command& out);
+
+// Execute one command (output through Log). False on failure, with a reason in error for bad input.
+bool runCommand(const Command& cmd, HospitalModules& m, std::string& error);
+
+// Run every command from source (a file path, or "-" for stdin). Returns the process exit code.
+int runBatch(const std::string& source);
+
+#endif // BATCH_MODE_HPP
@@ -0,0 +1,117 @@
+// BinarySnapshot.cpp
+// Implementation of the binary snapshot writer/reader (see BinarySnapshot.hpp for the layout).
+// Complexity: write O(n) bulk; read O(n) bulk memcpy of the fixed-width tables, strings by offset.
+
+#include "BinarySnapshot.hpp"
+#include "Journal.hpp"   // Journal::replaceFile (atomic rename)
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+using namespace std;
+
+namespace BinarySnapshot {
+
+static const char MAGIC[4] = { 'H', 'M', 'S', 'B' };
+static const uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+struct Header {
+    char     magic[4];
+    uint16_t version;
+    uint16_t kind;
+    uint32_t byteOrder;
+    uint32_t recordCount;
+    uint32_t intFields;
+    uint32_t strFields;
+    uint32_t blobSize;
+};
+
+Writer::Writer(Kind kind, uint32_t intFields, uint32_t strFields)
+    : kind_(kind), intFields_(intFields), strFields_(strFields), count_(0) {
+    offsets_.push_back(0);
+}
+
+void Writer::reserve(size_t records) {
+    ints_.reserve(records * intFields_);
+    offsets_.reserve(records * strFields_ + 1);
+}
+
+void Writer::addRecord(const int32_t* ints, const string_view* strs) {
+    ints_.insert(ints_.end(), ints, ints + intFields_);
+    for (uint32_t i = 0; i < strFields_; ++i) {
+        blob_.append(strs[i].data(), strs[i].size());
+        offsets_.push_back(static_cast<uint32_t>(blob_.size()));
+    }
+    count_++;
+}
+
+bool Writer::writeTo(const string& path) const {
+    Header h;
+    memcpy(h.magic, MAGIC, 4);
+    h.version = VERSION;
+    h.kind = kind_;
+    h.byteOrder = BYTE_ORDER_MARK;
+    h.recordCount = count_;
+    h.intFields = intFields_;
+    h.strFields = strFields_;
+    h.blobSize = static_cast<uint32_t>(blob_.size());
+
+    string tmp = path + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    if (ok && !ints_.empty())
+        ok = fwrite(ints_.data(), sizeof(int32_t), ints_.size(), f) == ints_.size();
+    if (ok) ok = fwrite(offsets_.data(), sizeof(uint32_t), offsets_.size(), f) == offsets_.size();
+    if (ok && !blob_.empty()) ok = fwrite(blob_.data(), 1, blob_.size(), f) == blob_.size();
+    ok = (fclose(f) == 0) && ok;
+    return ok && Journal::replaceFile(tmp, path);
+}
+
+bool Reader::open(const string& path, Kind kind, uint32_t intFields, uint32_t strFields) {
+    if (!file_.open(path)) return false;
+    string_view data = file_.view();
+    if (data.size() < sizeof(Header)) return false;
+
+    Header h;
+    memcpy(&h, data.data(), sizeof(h));
+    if (memcmp(h.magic, MAGIC, 4) != 0 || h.version != VERSION || h.kind != kind ||
+        h.byteOrder != BYTE_ORDER_MARK || h.intFields != intFields || h.strFields != strFields) {
+        return false;   // Unknown/foreign file: caller falls back to the CSV.
+    }
+
+    size_t intBytes = static_cast<size_t>(h.recordCount) * intFields * sizeof(int32_t);
+    size_t offCount = static_cast<size_t>(h.recordCount) * strFields + 1;
+    size_t offBytes = offCount * sizeof(uint32_t);
+    if (data.size() != sizeof(Header) + intBytes + offBytes + h.blobSize) return false;
+
+    const char* p = data.data() + sizeof(Header);
+    ints_.resize(static_cast<size_t>(h.recordCount) * intFields);
+    if (intBytes) memcpy(ints_.data(), p, intBytes);
+    offsets_.resize(offCount);
+    memcpy(offsets_.data(), p + intBytes, offBytes);
+    blob_ = p + intBytes + offBytes;
+
+    // Offsets must be monotonic and inside the blob, or string access would run off the end.
+    for (size_t i = 0; i + 1 < offCount; ++i) {
+        if (offsets_[i] > offsets_[i + 1]) return false;
+    }
+    if (offsets_[0] != 0 || offsets_[offCount - 1] != h.blobSize) return false;
+
+    count_ = h.recordCount;
+    intFields_ = intFields;
+    strFields_ = strFields;
+    return true;
+}
+
+bool preferBinary(const string& binPath, const string& csvPath) {
+    error_code ec;
+    auto binTime = filesystem::last_write_time(binPath, ec);
+    if (ec) return false;
+    auto csvTime = filesystem::last_write_time(csvPath, ec);
+    if (ec) return true;
+    return binTime >= csvTime;
+}
+
+} // namespace BinarySnapshot
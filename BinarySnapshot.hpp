@@ -0,0 +1,81 @@
+// BinarySnapshot.hpp
+// Optional versioned binary snapshot (data/*.bin) written alongside each module's CSV.
+// Why?
+// - The CSV files stay the human-editable interchange format; the .bin files are the
+//   fast-restart path: fixed-width integer columns + a string-offset table, loaded with one
+//   bulk read and no per-field text parsing.
+// - Startup prefers the .bin when it is at least as new as the matching CSV (a hand-edited
+//   CSV is newer, so it wins automatically).
+//
+// File layout (all integers little-endian as written by this build, checked via byteOrder):
+//   Header   magic "HMSB", u16 version, u16 kind, u32 byteOrder, u32 recordCount,
+//            u32 intFields, u32 strFields, u32 blobSize
+//   Ints     i32[recordCount * intFields]            (row-major, one row per record)
+//   Offsets  u32[recordCount * strFields + 1]        (string i spans [off[i], off[i+1]) in Blob)
+//   Blob     char[blobSize]                          (all string bytes, no terminators)
+
+#ifndef BINARY_SNAPSHOT_HPP
+#define BINARY_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "MappedFile.hpp"
+
+namespace BinarySnapshot {
+
+const uint16_t VERSION = 1;
+
+// One record kind per module (guards against loading the wrong file).
+enum Kind : uint16_t {
+    PATIENTS   = 1,
+    SUPPLIES   = 2,
+    EMERGENCY  = 3,
+    AMBULANCES = 4
+};
+
+// Accumulates records in memory, then writes the file in one go (temp file + rename).
+class Writer {
+public:
+    Writer(Kind kind, uint32_t intFields, uint32_t strFields);
+
+    void reserve(size_t records);
+    void addRecord(const int32_t* ints, const std::string_view* strs);
+    bool writeTo(const std::string& path) const;
+
+private:
+    Kind kind_;
+    uint32_t intFields_, strFields_;
+    uint32_t count_;
+    std::vector<int32_t> ints_;
+    std::vector<uint32_t> offsets_;
+    std::string blob_;
+};
+
+// Maps a snapshot and exposes typed column access; validates header, sizes and offsets.
+class Reader {
+public:
+    bool open(const std::string& path, Kind kind, uint32_t intFields, uint32_t strFields);
+
+    uint32_t count() const { return count_; }
+    int32_t intAt(uint32_t record, uint32_t field) const { return ints_[record * intFields_ + field]; }
+    std::string_view strAt(uint32_t record, uint32_t field) const {
+        uint32_t i = record * strFields_ + field;
+        return std::string_view(blob_ + offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+private:
+    MappedFile file_;
+    uint32_t count_ = 0, intFields_ = 0, strFields_ = 0;
+    std::vector<int32_t> ints_;       // Bulk-copied (alignment-safe) integer columns
+    std::vector<uint32_t> offsets_;   // Bulk-copied string-offset table
+    const char* blob_ = nullptr;      // Points into the mapping
+};
+
+// True if binPath exists and is not older than csvPath (or csvPath is missing).
+bool preferBinary(const std::string& binPath, const std::string& csvPath);
+
+} // namespace BinarySnapshot
+
+#endif // BINARY_SNAPSHOT_HPP
@@ -0,0 +1,100 @@
+// ChunkedStore.hpp
+// Shared growable backing store used by Role 1 (patient queue) and Role 3 (triage heap).
+// Data Structure Choice: DIRECTORY OF FIXED-SIZE CHUNKS
+// Why chunks instead of one resizable array?
+// - Growth appends a new chunk; existing elements never move (no copy of strings on growth).
+// - Only the small directory of chunk pointers is ever reallocated (doubling, amortised O(1)).
+// - Elements inside a chunk are contiguous, so linear scans stay cache-friendly.
+// - Trailing chunks are released when the store shrinks, so memory tracks live records
+//   instead of a worst-case MAX_* capacity.
+// Indexing: element i lives in chunk (i >> CHUNK_BITS) at slot (i & (CHUNK - 1)) — O(1).
+
+#ifndef CHUNKED_STORE_HPP
+#define CHUNKED_STORE_HPP
+
+#include <utility>
+
+template <typename T, int CHUNK_BITS = 6>
+class ChunkedStore {
+public:
+    static const int CHUNK = 1 << CHUNK_BITS;   // Elements per chunk (64 by default)
+
+    ChunkedStore() : chunks_(nullptr), numChunks_(0), dirCap_(0), size_(0) {}
+    ~ChunkedStore() { releaseAll(); }
+
+    // Owning raw chunks: copying would double-free, so forbid it.
+    ChunkedStore(const ChunkedStore&) = delete;
+    ChunkedStore& operator=(const ChunkedStore&) = delete;
+
+    int size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    int capacity() const { return numChunks_ * CHUNK; }
+
+    T& operator[](int i) { return chunks_[i >> CHUNK_BITS][i & (CHUNK - 1)]; }
+    const T& operator[](int i) const { return chunks_[i >> CHUNK_BITS][i & (CHUNK - 1)]; }
+
+    T& back() { return (*this)[size_ - 1]; }
+
+    // Amortised O(1): allocates a chunk only every CHUNK appends.
+    void push_back(const T& value) {
+        ensureCapacity(size_ + 1);
+        (*this)[size_++] = value;
+    }
+    void push_back(T&& value) {
+        ensureCapacity(size_ + 1);
+        (*this)[size_++] = std::move(value);
+    }
+
+    // O(1): resets the slot (frees string payloads) and trims spare chunks.
+    void pop_back() {
+        if (size_ == 0) return;
+        (*this)[--size_] = T();
+        trimSpare();
+    }
+
+    // Make room for at least n elements without moving existing ones.
+    void reserve(int n) { ensureCapacity(n); }
+
+    // Drop all elements and return every chunk to the allocator.
+    void clear() { releaseAll(); }
+
+private:
+    T**  chunks_;     // Directory of chunk pointers
+    int  numChunks_;  // Chunks currently allocated
+    int  dirCap_;     // Directory slots available
+    int  size_;       // Live element count
+
+    void ensureCapacity(int n) {
+        while (numChunks_ * CHUNK < n) {
+            if (numChunks_ == dirCap_) {
+                // Grow the directory only (pointer copy); element storage stays put.
+                int newCap = dirCap_ == 0 ? 4 : dirCap_ * 2;
+                T** dir = new T*[newCap];
+                for (int i = 0; i < numChunks_; ++i) dir[i] = chunks_[i];
+                delete[] chunks_;
+                chunks_ = dir;
+                dirCap_ = newCap;
+            }
+            chunks_[numChunks_++] = new T[CHUNK];
+        }
+    }
+
+    // Keep one spare chunk as hysteresis so push/pop at a boundary does not thrash.
+    void trimSpare() {
+        int needed = (size_ + CHUNK - 1) / CHUNK;
+        while (numChunks_ > needed + 1) {
+            delete[] chunks_[--numChunks_];
+        }
+    }
+
+    void releaseAll() {
+        for (int i = 0; i < numChunks_; ++i) delete[] chunks_[i];
+        delete[] chunks_;
+        chunks_ = nullptr;
+        numChunks_ = 0;
+        dirCap_ = 0;
+        size_ = 0;
+    }
+};
+
+#endif // CHUNKED_STORE_HPP
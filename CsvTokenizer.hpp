@@ -0,0 +1,196 @@
+// CsvTokenizer.hpp
+// Shared zero-copy CSV tokenizer used by all four modules' loaders and journal replay.
+// Why a shared tokenizer?
+// - Every loader used to split lines with std::stringstream + getline or find + substr,
+//   which heap-allocates one std::string per field and relies on stoi (throws on bad input).
+// - Here fields are std::string_view slices of the caller's buffer: no allocation while
+//   splitting; strings are only materialised when a record field is actually assigned.
+// - Numbers go through std::from_chars (no allocation, no exceptions, no locale).
+// Usage:
+//   CsvLineReader lines(buffer);            // iterate lines of a whole-file buffer
+//   CsvTokenizer tok(line);                 // iterate comma-separated fields of one line
+//   tok.next(f); tok.rest();                // next field / remainder (free-text last column)
+//   tok.nextQuoted(f); assignCsvText(f, s); // same, honouring "quoted, fields" ("" = one quote)
+
+#ifndef CSV_TOKENIZER_HPP
+#define CSV_TOKENIZER_HPP
+
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+// Strip leading/trailing whitespace from a view (no copy).
+inline std::string_view trimView(std::string_view s) {
+    size_t b = 0, e = s.size();
+    while (b < e && (s[b] == ' ' || s[b] == '\t' || s[b] == '\r' || s[b] == '\n')) ++b;
+    while (e > b && (s[e - 1] == ' ' || s[e - 1] == '\t' || s[e - 1] == '\r' || s[e - 1] == '\n')) --e;
+    return s.substr(b, e - b);
+}
+
+// Parse a (whitespace-tolerant) integer field. Returns false instead of throwing.
+// Like stoi, a valid numeric prefix is accepted ("6 extra" -> 6).
+inline bool parseIntField(std::string_view field, int& out) {
+    field = trimView(field);
+    if (!field.empty() && field[0] == '+') field.remove_prefix(1);
+    const char* first = field.data();
+    const char* last = first + field.size();
+    auto res = std::from_chars(first, last, out);
+    return res.ec == std::errc() && res.ptr != first;
+}
+
+// Same for 64-bit fields (timestamps).
+inline bool parseIntField(std::string_view field, long long& out) {
+    field = trimView(field);
+    if (!field.empty() && field[0] == '+') field.remove_prefix(1);
+    const char* first = field.data();
+    const char* last = first + field.size();
+    auto res = std::from_chars(first, last, out);
+    return res.ec == std::errc() && res.ptr != first;
+}
+
+class CsvTokenizer {
+public:
+    explicit CsvTokenizer(std::string_view line, char delim = ',')
+        : line_(line), pos_(0), delim_(delim), done_(false) {}
+
+    // Next field (up to the delimiter or end of line). False once the line is exhausted.
+    bool next(std::string_view& field) {
+        if (done_) return false;
+        size_t cut = line_.find(delim_, pos_);
+        if (cut == std::string_view::npos) {
+            field = line_.substr(pos_);
+            done_ = true;
+        } else {
+            field = line_.substr(pos_, cut - pos_);
+            pos_ = cut + 1;
+        }
+        return true;
+    }
+
+    // Like next(), but a field whose first non-blank character is '"' runs to its closing quote:
+    // delimiters and doubled quotes inside belong to the field. The field is returned raw (quotes
+    // included, see assignCsvText). An unterminated quote takes the rest of the line.
+    bool nextQuoted(std::string_view& field) {
+        if (!startsQuoted()) return next(field);
+        size_t q = line_.find('"', pos_) + 1;
+        while (q < line_.size()) {
+            if (line_[q] == '"') {
+                if (q + 1 < line_.size() && line_[q + 1] == '"') {
+                    q += 2;   // Escaped quote
+                    continue;
+                }
+                break;        // Closing quote
+            }
+            ++q;
+        }
+        size_t cut = q < line_.size() ? line_.find(delim_, q) : std::string_view::npos;
+        if (cut == std::string_view::npos) {
+            field = line_.substr(pos_);
+            done_ = true;
+        } else {
+            field = line_.substr(pos_, cut - pos_);
+            pos_ = cut + 1;
+        }
+        return true;
+    }
+
+    // Remainder as one field: quoted -> up to the closing quote, otherwise rest(). Raw, like nextQuoted.
+    std::string_view restQuoted() {
+        std::string_view field;
+        if (!startsQuoted()) return rest();
+        nextQuoted(field);
+        done_ = true;
+        return field;
+    }
+
+    // Everything after the last consumed delimiter (free-text columns that may contain commas).
+    std::string_view rest() {
+        if (done_) return std::string_view();
+        done_ = true;
+        return line_.substr(pos_);
+    }
+
+    // True if the unconsumed remainder still contains a delimiter.
+    bool hasMoreDelimiters() const {
+        return !done_ && line_.find(delim_, pos_) != std::string_view::npos;
+    }
+
+    bool done() const { return done_; }
+
+private:
+    bool startsQuoted() const {
+        if (done_) return false;
+        size_t p = pos_;
+        while (p < line_.size() && (line_[p] == ' ' || line_[p] == '\t')) ++p;
+        return p < line_.size() && line_[p] == '"';
+    }
+
+    std::string_view line_;
+    size_t pos_;
+    char delim_;
+    bool done_;
+};
+
+// Assign a field read by nextQuoted()/restQuoted(): trimmed, and if quoted without the quotes with
+// "" folded to ". Reuses out's capacity (no allocation once the string is large enough).
+inline void assignCsvText(std::string_view raw, std::string& out) {
+    raw = trimView(raw);
+    if (raw.empty() || raw[0] != '"') {
+        out.assign(raw.data(), raw.size());
+        return;
+    }
+    raw.remove_prefix(1);
+    size_t close = raw.rfind('"');
+    if (close != std::string_view::npos) raw = raw.substr(0, close);
+    out.clear();
+    for (size_t i = 0; i < raw.size(); ++i) {
+        out.push_back(raw[i]);
+        if (raw[i] == '"' && i + 1 < raw.size() && raw[i + 1] == '"') ++i;
+    }
+}
+
+// True if text must be quoted to survive a round trip: delimiter, quote, or edge whitespace.
+inline bool csvNeedsQuotes(std::string_view text, char delim = ',') {
+    if (text.empty()) return false;
+    auto blank = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+    if (blank(text.front()) || blank(text.back())) return true;
+    for (char c : text) {
+        if (c == delim || c == '"') return true;
+    }
+    return false;
+}
+
+// Iterates the lines of a buffer; strips a trailing '\r' (files edited on Windows).
+class CsvLineReader {
+public:
+    explicit CsvLineReader(std::string_view buffer) : buf_(buffer), pos_(0) {}
+
+    bool nextLine(std::string_view& line) {
+        if (pos_ >= buf_.size()) return false;
+        size_t nl = buf_.find('\n', pos_);
+        if (nl == std::string_view::npos) nl = buf_.size();
+        line = buf_.substr(pos_, nl - pos_);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        pos_ = nl + 1;
+        return true;
+    }
+
+private:
+    std::string_view buf_;
+    size_t pos_;
+};
+
+// Read a whole file into `out` with one bulk read. False if it cannot be opened.
+inline bool readFileToBuffer(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    in.seekg(0, std::ios::end);
+    std::streamoff len = in.tellg();
+    in.seekg(0, std::ios::beg);
+    out.resize(len > 0 ? static_cast<size_t>(len) : 0);
+    if (len > 0) in.read(&out[0], len);
+    return true;
+}
+
+#endif // CSV_TOKENIZER_HPP
@@ -0,0 +1,261 @@
+// DispatchEngine.cpp
+// Implementation of the emergency -> ambulance dispatch engine (see DispatchEngine.hpp).
+// Complexity: pickUnit / dispatchNext O(log n + k) for k on-duty units (plus the O(log m) heap
+// pop of the case); state changes O(1) with one journal append each.
+
+#include "DispatchEngine.hpp"
+#include "CsvTokenizer.hpp"
+#include "DutyClock.hpp"
+#include "Log.hpp"
+#include "MappedFile.hpp"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+static const char* DISPATCH_FILE = "data/dispatch.txt";   // Snapshot: ID,State,LastDispatch,PatientID
+
+DispatchEngine::DispatchEngine(EmergencyDepartment& emergency, Ambulance& fleet)
+    : emergency_(emergency), fleet_(fleet), nextSeq_(1), journal_("data/dispatch.log") {
+    load();
+    if (journal_.replay([this](string_view e) { applyEntry(e); }) > 0) compact();
+}
+
+DispatchEngine::~DispatchEngine() {
+    if (journal_.entries() > 0) compact();
+}
+
+// ===========================================================
+// Unit Selection
+// ===========================================================
+int DispatchEngine::pickUnit(int minute) const {
+    int best = -1;
+    unsigned long bestSeq = 0;
+    for (int id : fleet_.onDutyAt(minute)) {
+        auto it = units_.find(id);
+        if (it != units_.end() && it->second.state != UnitState::AVAILABLE) continue;   // Busy
+
+        const Ambulance::Record* r = fleet_.recordOf(id);
+        if (!r) continue;
+        if (r->shiftStart != 0 || r->shiftEnd != ShiftIndex::MINUTES_PER_DAY) {   // 00:00-24:00 never hands over
+            int left = (r->shiftEnd - minute + ShiftIndex::MINUTES_PER_DAY) % ShiftIndex::MINUTES_PER_DAY;
+            if (left < options_.minShiftRemaining) continue;
+        }
+
+        unsigned long seq = it == units_.end() ? 0 : it->second.lastDispatch;
+        if (best < 0 || seq < bestSeq || (seq == bestSeq && id < best)) {
+            best = id;
+            bestSeq = seq;
+        }
+    }
+    return best;
+}
+
+bool DispatchEngine::dispatchNext(int minute, Assignment& out, string& error) {
+    emergency_.drainIntake();
+    if (emergency_.pendingCount() == 0) {
+        error = "no pending emergency cases";
+        return false;
+    }
+    int unit = pickUnit(minute);   // Before the pop: with no unit the case stays queued
+    if (unit < 0) {
+        error = "no available ambulance on duty at " + Ambulance::minutesToTime(minute);
+        return false;
+    }
+    if (!emergency_.takeNextCase(out.emergency)) {
+        error = "no pending emergency cases";
+        return false;
+    }
+
+    Unit& u = units_[unit];
+    u.state = UnitState::EN_ROUTE;
+    u.lastDispatch = nextSeq_++;
+    u.patientId = out.emergency.patientID;
+    logUnit(unit, u);
+    emergency_.recordDispatch(out.emergency.patientID, unit);
+
+    out.ambulanceId = unit;
+    const Ambulance::Record* r = fleet_.recordOf(unit);
+    out.vehicleReg = r ? r->vehicleReg : string();
+
+    Log::result() << "[✓] Dispatched ambulance " << unit << " (" << out.vehicleReg << ") to "
+                  << out.emergency.patientName << " [" << out.emergency.emergencyType
+                  << ", priority " << out.emergency.priority << "].\n";
+    return true;
+}
+
+// ===========================================================
+// Unit State
+// ===========================================================
+// from = the only state the change is allowed from (AVAILABLE as `from` means "any busy state").
+bool DispatchEngine::setState(int ambulanceId, UnitState from, UnitState to) {
+    auto it = units_.find(ambulanceId);
+    bool busy = it != units_.end() && it->second.state != UnitState::AVAILABLE;
+    bool allowed = from == UnitState::AVAILABLE ? busy : (busy && it->second.state == from);
+    if (!allowed) {
+        Log::error() << "Ambulance " << ambulanceId << " is not "
+                     << (from == UnitState::AVAILABLE ? "out on a call" : stateName(from)) << ".\n";
+        return false;
+    }
+    it->second.state = to;
+    logUnit(ambulanceId, it->second);
+    Log::result() << "Ambulance " << ambulanceId << " is now " << stateName(to) << ".\n";
+    return true;
+}
+
+bool DispatchEngine::markReturning(int ambulanceId) {
+    return setState(ambulanceId, UnitState::EN_ROUTE, UnitState::RETURNING);
+}
+
+bool DispatchEngine::markAvailable(int ambulanceId) {   // From en-route too (call cancelled)
+    return setState(ambulanceId, UnitState::AVAILABLE, UnitState::AVAILABLE);
+}
+
+DispatchEngine::UnitState DispatchEngine::state(int ambulanceId) const {
+    auto it = units_.find(ambulanceId);
+    return it == units_.end() ? UnitState::AVAILABLE : it->second.state;
+}
+
+const char* DispatchEngine::stateName(UnitState s) {
+    switch (s) {
+        case UnitState::EN_ROUTE: return "en-route";
+        case UnitState::RETURNING: return "returning";
+        default: return "available";
+    }
+}
+
+// ===========================================================
+// Persistence — Journal (data/dispatch.log) + snapshot (data/dispatch.txt)
+// ===========================================================
+// Entry format: S,<ambulanceId>,<state>,<lastDispatch>,<patientId>  (full unit state: idempotent)
+void DispatchEngine::logUnit(int ambulanceId, const Unit& u) {
+    string entry = "S," + to_string(ambulanceId) + "," + to_string(static_cast<int>(u.state)) + ","
+                   + to_string(u.lastDispatch) + "," + to_string(u.patientId);
+    if (!journal_.append(entry)) {
+        Log::error() << "[!] Could not write dispatch.log.\n";
+        return;
+    }
+    if (journal_.needsCompaction()) compact();
+}
+
+void DispatchEngine::applyEntry(string_view entry) {
+    if (entry.size() > 2 && entry[0] == 'S' && entry[1] == ',') entry.remove_prefix(2);
+    CsvTokenizer tok(entry);
+    string_view idField, stateField, seqField, patientField;
+    int id, st, seq, patient;
+    if (!tok.next(idField) || !tok.next(stateField) || !tok.next(seqField) || !tok.next(patientField) ||
+        !parseIntField(idField, id) || !parseIntField(stateField, st) || !parseIntField(seqField, seq) ||
+        !parseIntField(patientField, patient) || st < 0 || st > 2 || seq < 0) return;
+
+    Unit& u = units_[id];
+    u.state = static_cast<UnitState>(st);
+    u.lastDispatch = static_cast<unsigned long>(seq);
+    u.patientId = patient;
+    if (u.lastDispatch >= nextSeq_) nextSeq_ = u.lastDispatch + 1;
+}
+
+void DispatchEngine::load() {
+    MappedFile file;
+    if (!file.open(DISPATCH_FILE)) return;   // First run: every unit available
+    CsvLineReader lines(file.view());
+    string_view line;
+    while (lines.nextLine(line)) applyEntry(line);   // The header line fails to parse and is skipped
+    Log::status() << "[✓] Loaded dispatch state for " << units_.size() << " units.\n";
+}
+
+void DispatchEngine::compact() {
+    string tmp = string(DISPATCH_FILE) + ".tmp";
+    ofstream out(tmp);
+    out << "ID,State,LastDispatch,PatientID\n";
+    for (const auto& e : units_) {
+        out << e.first << "," << static_cast<int>(e.second.state) << ","
+            << e.second.lastDispatch << "," << e.second.patientId << "\n";
+    }
+    out.close();
+    if (out.good() && Journal::replaceFile(tmp, DISPATCH_FILE)) journal_.truncate();
+}
+
+// ===========================================================
+// Display + Menu
+// ===========================================================
+void DispatchEngine::displayFleetStatus(int minute) const {
+    ostream& out = Log::result();   // Per-terminal buffer in service mode, honours --quiet
+    vector<int> ids = fleet_.onDutyAt(minute);
+    out << "\n--- Units on duty at " << Ambulance::minutesToTime(minute) << " ---\n";
+    if (ids.empty()) {
+        out << "No ambulances on duty.\n";
+        return;
+    }
+    out << left << setw(5) << "ID" << setw(16) << "Vehicle" << setw(12) << "Shift End"
+        << setw(11) << "State" << "Last Case\n";
+    for (int id : ids) {
+        const Ambulance::Record* r = fleet_.recordOf(id);
+        if (!r) continue;
+        auto it = units_.find(id);
+        out << left << setw(5) << id << setw(16) << r->vehicleReg
+            << setw(12) << Ambulance::minutesToTime(r->shiftEnd) << setw(11) << stateName(state(id));
+        if (it != units_.end() && it->second.patientId > 0) out << it->second.patientId;
+        else out << "-";
+        out << "\n";
+    }
+    int next = pickUnit(minute);
+    if (next > 0) out << "Next dispatch: ambulance " << next << "\n";
+    else out << "Next dispatch: none eligible\n";
+}
+
+void DispatchEngine::displayMenu() {
+    int choice;
+    do {
+        fleet_.tick();
+        cout << "\n====== EMERGENCY DISPATCH MENU ======\n"
+             << "1. Dispatch Ambulance to Most Critical Case\n"
+             << "2. Mark Unit Returning\n"
+             << "3. Mark Unit Available\n"
+             << "4. View Fleet Status\n"
+             << "0. Back to Main Menu\n"
+             << "------------------------------------\n"
+             << "Enter your choice: ";
+        cin >> choice;
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            choice = -1;
+        }
+
+        int minute = DutyClock::wallClock().minuteOfDay;
+        switch (choice) {
+            case 1: {
+                Assignment a;
+                string error;
+                if (!dispatchNext(minute, a, error)) Log::error() << "[!] Cannot dispatch: " << error << ".\n";
+                break;
+            }
+            case 2:
+            case 3: {
+                int id;
+                cout << "Enter ambulance ID: ";
+                cin >> id;
+                if (cin.fail()) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid ID.\n";
+                    break;
+                }
+                if (choice == 2) markReturning(id);
+                else markAvailable(id);
+                break;
+            }
+            case 4:
+                displayFleetStatus(minute);
+                break;
+            case 0:
+                cout << "Returning to main menu...\n";
+                break;
+            default:
+                cout << "Invalid choice. Please try again.\n";
+        }
+    } while (choice != 0);
+}
@@ -0,0 +1,90 @@
+// DispatchEngine.hpp
+// Links Role 3 and Role 4: sends the best available ambulance to the most critical emergency.
+// Data Structure Choice: INTERVAL-INDEX QUERY + PER-UNIT STATE TABLE (hash map)
+// Why?
+// - Candidates come from Ambulance::onDutyAt() (the ShiftIndex interval tree): O(log n + k) for
+//   the k units on shift now, instead of walking the whole roster on every call.
+// - Each unit carries a state (AVAILABLE -> EN_ROUTE -> RETURNING -> AVAILABLE) and the sequence
+//   number of its last dispatch in an O(1) hash table, so busy units are skipped in O(1) each.
+// - Units whose shift ends within Options::minShiftRemaining minutes are skipped: a crew should not
+//   be sent out just before handing over the vehicle.
+// - Fairness: among the eligible units the one dispatched least recently wins (never-dispatched
+//   first, then by ID), so work spreads across the rotation instead of always hitting the head.
+// - The result goes back to the emergency record (EmergencyDepartment::recordDispatch, journaled
+//   as D,<case>,<unit>); unit states are journaled to data/dispatch.log and folded into
+//   data/dispatch.txt on compaction, like every other module.
+// A dispatch is picked before the case is popped, so with no eligible unit the case stays queued.
+
+#ifndef DISPATCH_ENGINE_HPP
+#define DISPATCH_ENGINE_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Ambulance.hpp"
+#include "Emergency.hpp"
+#include "Journal.hpp"
+
+class DispatchEngine {
+public:
+    enum class UnitState { AVAILABLE = 0, EN_ROUTE = 1, RETURNING = 2 };
+
+    struct Options {
+        int minShiftRemaining = 30;   // Minutes; units closer to their shift end are not sent
+    };
+
+    struct Assignment {
+        EmergencyCase emergency;
+        int ambulanceId;
+        std::string vehicleReg;
+    };
+
+    DispatchEngine(EmergencyDepartment& emergency, Ambulance& fleet);
+    ~DispatchEngine();   // Final compaction
+
+    DispatchEngine(const DispatchEngine&) = delete;
+    DispatchEngine& operator=(const DispatchEngine&) = delete;
+
+    // Best eligible unit at minute (0-1439), or -1. O(log n + k), no side effects.
+    int pickUnit(int minute) const;
+
+    // Pop the most critical case and send pickUnit(minute) to it. False (nothing changed) when there
+    // is no pending case or no eligible unit; `error` says which.
+    bool dispatchNext(int minute, Assignment& out, std::string& error);
+
+    // Crew reports: on scene / leaving the hospital -> RETURNING; back at base (or call cancelled
+    // while en route) -> AVAILABLE.
+    bool markReturning(int ambulanceId);
+    bool markAvailable(int ambulanceId);
+
+    UnitState state(int ambulanceId) const;
+    static const char* stateName(UnitState s);
+
+    void setOptions(const Options& options) { options_ = options; }
+    const Options& options() const { return options_; }
+
+    void displayFleetStatus(int minute) const;   // On-duty units with state and last case
+    void displayMenu();
+
+private:
+    struct Unit {
+        UnitState state = UnitState::AVAILABLE;
+        unsigned long lastDispatch = 0;   // Sequence number of the latest dispatch (0 = never)
+        int patientId = 0;                // Case being served / last served
+    };
+
+    bool setState(int ambulanceId, UnitState from, UnitState to);
+    void logUnit(int ambulanceId, const Unit& u);
+    void applyEntry(std::string_view entry);   // Idempotent: "S,id,state,seq,patient" or snapshot line
+    void load();
+    void compact();
+
+    EmergencyDepartment& emergency_;
+    Ambulance& fleet_;
+    std::unordered_map<int, Unit> units_;      // Only units that have ever been dispatched
+    unsigned long nextSeq_;
+    Options options_;
+    Journal journal_;
+};
+
+#endif // DISPATCH_ENGINE_HPP
@@ -0,0 +1,93 @@
+// DutyClock.cpp
+// Implementation of the shift-boundary event engine (see DutyClock.hpp).
+// Complexity: set O(log n); cancel O(1); advance O(k log n) for k due events.
+
+#include "DutyClock.hpp"
+#include <ctime>
+
+using namespace std;
+
+DutyClock::Now DutyClock::wallClock() {
+    time_t t = time(nullptr);
+    struct tm local;
+#ifdef _WIN32
+    localtime_s(&local, &t);
+#else
+    localtime_r(&t, &local);   // Reentrant: modules may run on different service threads
+#endif
+    Now now;
+    now.absMinute = static_cast<long long>(t) / 60;
+    now.minuteOfDay = local.tm_hour * 60 + local.tm_min;
+    return now;
+}
+
+bool DutyClock::covers(int shiftStart, int shiftEnd, int minute) {
+    if (shiftStart == 0 && shiftEnd == 0) return false;              // Not assigned
+    if (shiftStart < shiftEnd) return minute >= shiftStart && minute < shiftEnd;
+    return minute >= shiftStart || minute < shiftEnd;                 // Overnight
+}
+
+int DutyClock::subscribe(Listener listener) {
+    int token = listeners_.empty() ? 1 : listeners_.back().first + 1;
+    listeners_.push_back(make_pair(token, std::move(listener)));
+    return token;
+}
+
+void DutyClock::unsubscribe(int token) {
+    for (size_t i = 0; i < listeners_.size(); ++i) {
+        if (listeners_[i].first == token) {
+            listeners_.erase(listeners_.begin() + i);
+            return;
+        }
+    }
+}
+
+void DutyClock::emit(int id, bool onDuty) {
+    for (auto& l : listeners_) l.second(id, onDuty);
+}
+
+long long DutyClock::nextOccurrence(int minuteOfDay, Now now) {
+    int delta = (minuteOfDay - now.minuteOfDay + MINUTES_PER_DAY) % MINUTES_PER_DAY;
+    if (delta == 0) delta = MINUTES_PER_DAY;   // This minute's boundary is already reflected in the state
+    return now.absMinute + delta;
+}
+
+void DutyClock::set(int id, int shiftStart, int shiftEnd, bool current, Now now) {
+    Unit& u = units_[id];
+    u.gen = nextGen_++;   // Invalidates any events still queued for the old shift
+    u.onDuty = covers(shiftStart, shiftEnd, now.minuteOfDay);
+
+    // Constant state (unassigned / all day) needs no boundary events: for 0-1440 both would fall on
+    // midnight, and their order in the heap would decide the state.
+    bool constant = shiftStart == 0 && (shiftEnd == 0 || shiftEnd == MINUTES_PER_DAY);
+    if (!constant) {
+        events_.push({nextOccurrence(shiftStart, now), u.gen, id, true});
+        events_.push({nextOccurrence(shiftEnd, now), u.gen, id, false});
+    }
+    if (u.onDuty != current) emit(id, u.onDuty);
+}
+
+void DutyClock::cancel(int id) {
+    units_.erase(id);   // Queued events become stale (no unit / generation mismatch)
+}
+
+void DutyClock::clear() {
+    units_.clear();
+    events_ = decltype(events_)();
+}
+
+void DutyClock::advance(Now now) {
+    while (!events_.empty() && events_.top().at <= now.absMinute) {
+        Event e = events_.top();
+        events_.pop();
+        auto it = units_.find(e.id);
+        if (it == units_.end() || it->second.gen != e.gen) continue;   // Stale
+
+        if (it->second.onDuty != e.on) {
+            it->second.onDuty = e.on;
+            emit(e.id, e.on);
+        }
+        e.at += MINUTES_PER_DAY;   // Same boundary tomorrow
+        events_.push(e);
+    }
+}
@@ -0,0 +1,77 @@
+// DutyClock.hpp
+// Event-driven on/off-duty engine for Role 4 (replaces polling every unit on every refresh).
+// Data Structure Choice: MIN-HEAP OF UPCOMING SHIFT BOUNDARIES
+// Why?
+// - Each unit with a real shift has exactly two pending events (its next start and next end,
+//   as absolute minutes). advance() pops only the boundaries that have passed — O(k log n) for
+//   k transitions, zero work when nothing changed — and re-arms each one 24 hours later.
+// - Duty state is flipped exactly when a boundary passes, so readers of isOnDuty see a consistent
+//   snapshot without scanning the roster.
+// - Re-timing or removing a unit bumps a generation number instead of searching the heap;
+//   stale events are discarded when they surface (lazy deletion).
+// - Every transition is published to subscribers (e.g. dispatch), so they never poll either.
+// Times: shifts are local minutes-of-day (start 0-1439, end 0-1440), as in Ambulance::Record;
+// overnight shifts (start > end) work naturally, 0-0 means "not assigned", 0-1440 means all day.
+
+#ifndef DUTY_CLOCK_HPP
+#define DUTY_CLOCK_HPP
+
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DutyClock {
+public:
+    static const int MINUTES_PER_DAY = 1440;
+
+    // A moment in time: absolute minute counter + local minute of the day.
+    struct Now {
+        long long absMinute;
+        int minuteOfDay;
+    };
+    static Now wallClock();   // From time()/localtime()
+
+    using Listener = std::function<void(int id, bool onDuty)>;
+
+    DutyClock() : nextGen_(0) {}
+
+    int subscribe(Listener listener);   // Returns a token for unsubscribe()
+    void unsubscribe(int token);
+
+    // Track (or re-time) a unit. `current` is the state the caller holds now; a listener event is
+    // emitted if the shift says otherwise at `now`.
+    void set(int id, int shiftStart, int shiftEnd, bool current, Now now);
+    void cancel(int id);
+    void clear();   // Forget all units (subscribers stay)
+
+    // Fire every boundary at or before now, in time order.
+    void advance(Now now);
+
+    // Static rule shared with the interval index: does [start, end) (wrapping) cover minute?
+    static bool covers(int shiftStart, int shiftEnd, int minute);
+
+private:
+    struct Event {
+        long long at;        // Absolute minute
+        unsigned gen;        // Must match the unit's generation, or the event is stale
+        int id;
+        bool on;             // true = shift start, false = shift end
+        bool operator>(const Event& o) const { return at > o.at; }
+    };
+    struct Unit {
+        unsigned gen;
+        bool onDuty;
+    };
+
+    void emit(int id, bool onDuty);
+    static long long nextOccurrence(int minuteOfDay, Now now);
+
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+    std::unordered_map<int, Unit> units_;
+    std::vector<std::pair<int, Listener>> listeners_;
+    unsigned nextGen_;   // Global, so a removed-then-re-added ID never matches old events
+};
+
+#endif // DUTY_CLOCK_HPP
@@ -5,46 +5,173 @@
 // WHY PRIORITY QUEUE?
 // - Realism: Emergency cases differ in urgency; critical patients (priority 1)
 //   must be treated first, not just in arrival order.
-// - Approach: Implemented using array-based priority queue (sorted by priority).
-//   Lower number = higher priority (1 = most critical).
-// - Efficiency: Simpler than heap (since max 100 cases); O(n) insertion, O(1)
-//   retrieval of top-priority case — fine for hospital scale.
-// - Integration: Automatically loads existing emergencies from "emergency.txt"
-//   and imports new patients from "patients.txt".
+// - Approach: Implemented as an array-based binary min-heap keyed on
+//   (priority, arrivalSeq). Lower number = higher priority (1 = most critical);
+//   equal priorities are served first-come, first-served.
+// - Efficiency: O(log n) insertion, removal and priority change; O(1) peek at
+//   the top-priority case; O(n) heapify when loading from file.
+// - Integration: Automatically loads existing emergencies from "emergency.txt";
+//   new admissions arrive live over the event bus (PatientAdmitted), and
+//   "patients.txt" is only re-read on request (menu option 8 / import-patients).
 // - Reliability: Input validation, unique ID handling, sorting, and persistence.
+// - Persistence: "emergency.txt" is a snapshot of pending cases. Each change
+//   appends one journal record to "emergency.log" — L (logged), U (priority
+//   update), X (processed tombstone) — so durability is O(1) per operation.
+//   A background thread compacts the journal into the snapshot.
 // ============================================================================
 
 
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <limits>
 #include <unordered_set>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
 #include "Emergency.hpp"
+#include "BinarySnapshot.hpp"
+#include "CsvTokenizer.hpp"
+#include "MappedFile.hpp"
+#include "Log.hpp"
+#include "EventBus.hpp"
+#include "Metrics.hpp"
+#include "PagedView.hpp"
 using namespace std;
 
+static const char* EMERGENCY_FILE   = "data/emergency.txt";
+static const char* EMERGENCY_LOG    = "data/emergency.log";
+static const char* EMERGENCY_BIN    = "data/emergency.bin";             // Binary twin of emergency.txt
+static const char* EMERGENCY_ARCHIVE = "data/emergency.log.1";          // Journal being compacted
+static const char* RETIRED_FILE     = "data/emergency_retired.txt";     // Tombstoned (processed) IDs, append-only
+static const char* POLICY_FILE      = "data/triage_policy.txt";         // Aging policy (optional)
+static const long long STRICT_SPAN  = 1LL << 40;   // Key scale with aging off: priority dominates any arrival time
+static const size_t WAIT_SAMPLES_PER_LEVEL = 1024;
+
+// Rows of data/patients.txt (ID,Name,Condition, as PatientLayout) read straight into cases for the
+// on-demand import; the row ID is the admission ID and the condition becomes the emergency type.
+typedef RecordSchema::Layout<EmergencyCase,
+                             RecordSchema::Field<&EmergencyCase::admissionID>,
+                             RecordSchema::Field<&EmergencyCase::patientName>,
+                             RecordSchema::Field<&EmergencyCase::emergencyType, RecordSchema::REST>>
+    AdmissionRowLayout;
+
 // ===========================================================
 // Constructor — Initialize & Auto-load Data
 // ===========================================================
 // Loads previously logged emergency cases from "emergency.txt"
 // and new patient data from "patients.txt" (if available).
-EmergencyDepartment::EmergencyDepartment() {
-    size = 0;
+EmergencyDepartment::EmergencyDepartment()
+    : registry(PatientRegistry::shared()), nextID(1), journal(EMERGENCY_LOG), retiredLog(RETIRED_FILE),
+      compactionOk(true), intakeWaitNext(0) {
+    nextSeq = 0;
+    for (size_t p = 0; p < 11; ++p) servedWaitNext[p] = 0;
+    loadAgingPolicy();   // Before anything is keyed
     loadExistingEmergencies();
-    loadPatientsFromFile();
+    loadRetiredIds();
+
+    // Replay changes made since the last compaction (an archive means the
+    // previous compaction was interrupted — replay it first, in order).
+    auto apply = [this](string_view e) { applyJournalEntry(e); };
+    int replayed = Journal::replayFile(EMERGENCY_ARCHIVE, apply);
+    replayed += journal.replay(apply);
+    if (replayed > 0) Log::status() << "[✓] Replayed " << replayed << " journal records.\n";
+
+    seedIDAllocator();
+
+    // Live link to Role 1: each admission is queued for triage at default priority 6 as it
+    // happens (lock-free intake; drained with the next triage operation). No startup rescan.
+    // The case references the admission's registry record: no copy of the name or condition.
+    // Its case ID is issued on drain (the admission ID may already name a pending or processed case).
+    admissionToken = EventBus::patientAdmitted().subscribe([this](const EventBus::PatientAdmitted& p) {
+        registry.retain(p.patient);
+        IntakeItem item;
+        item.c.patientID = 0;
+        item.c.admissionID = p.id;
+        item.c.priority = 6;
+        item.c.arrivalTime = static_cast<long long>(time(nullptr));   // The wait starts now
+        item.patient = p.patient;
+        item.submittedAt = chrono::steady_clock::now();
+        intake.push(std::move(item));
+        Metrics::setGauge(Metrics::TRIAGE_INTAKE, intake.depth());
+    });
+    if (journal.entries() > 0 || replayed > 0) startCompaction();
+}
+
+EmergencyDepartment::~EmergencyDepartment() {
+    EventBus::patientAdmitted().unsubscribe(admissionToken);
+    drainIntake();   // Nothing submitted is lost: queued cases are journaled before the final compaction
+    waitForCompaction();
+    if (journal.entries() > 0) {
+        startCompaction();
+        waitForCompaction();
+    }
+    for (int i = 0; i < cases.size(); i++) registry.release(cases[i].patient);
 }
 
 // ===========================================================
-// Helper: Convert String to Lowercase
+// Helper: Lowercase into a Reused Buffer
 // ===========================================================
 // Ensures case-insensitive searches (e.g., "John" == "john").
-// O(n) time, where n = string length.
-string EmergencyDepartment::toLowerCase(string str) {
-    for (std::string::size_type i = 0; i < str.length(); ++i) {
-        if (str[i] >= 'A' && str[i] <= 'Z')
-            str[i] = str[i] + 32;
+// O(n) time, where n = string length; dst keeps its capacity,
+// so repeated queries do not allocate.
+void EmergencyDepartment::lowerInto(string_view src, string& dst) {
+    dst.assign(src.data(), src.size());
+    for (std::string::size_type i = 0; i < dst.length(); ++i) {
+        if (dst[i] >= 'A' && dst[i] <= 'Z')
+            dst[i] = dst[i] + 32;
     }
-    return str;
+}
+
+// ===========================================================
+// Search Indexes — Interned Lowercase Keys
+// ===========================================================
+// Each distinct lowercased name/type is stored once and referred
+// to by an int handle; postings map handle -> patient IDs.
+int EmergencyDepartment::internKey(string_view text) {
+    lowerInto(text, queryKey);
+    auto it = keyIds.find(queryKey);
+    if (it != keyIds.end()) return it->second;
+    int handle = static_cast<int>(keyText.size());
+    keyText.push_back(queryKey);
+    keyIds.emplace(queryKey, handle);
+    return handle;
+}
+
+int EmergencyDepartment::findKey(string_view text) {
+    lowerInto(text, queryKey);
+    auto it = keyIds.find(queryKey);
+    return it == keyIds.end() ? -1 : it->second;
+}
+
+void EmergencyDepartment::indexCase(const TriageEntry& e) {
+    PatientRegistry::Entry r = registry.get(e.patient);
+    int name = internKey(r.name);
+    int type = internKey(r.condition);
+    byNameKey[name].insert(e.patientID);
+    byTypeKey[type].insert(e.patientID);
+    if (typeOrder.find(keyText[type]) == typeOrder.end()) typeOrder.emplace(keyText[type], type);
+    caseKeys[e.patientID] = make_pair(name, type);
+}
+
+void EmergencyDepartment::unindexCase(int patientID) {
+    auto it = caseKeys.find(patientID);
+    if (it == caseKeys.end()) return;
+    byNameKey[it->second.first].erase(patientID);
+    byTypeKey[it->second.second].erase(patientID);
+    caseKeys.erase(it);
+}
+
+// Heap indices of the cases under one key, in triage order (O(k log k)).
+vector<int> EmergencyDepartment::matchingCases(const unordered_map<int, unordered_set<int>>& index,
+                                               int key) const {
+    vector<int> out;
+    auto it = index.find(key);
+    if (it == index.end()) return out;
+    out.reserve(it->second.size());
+    for (int id : it->second) out.push_back(heapPos.at(id));
+    sort(out.begin(), out.end(), [this](int a, int b) { return comesBefore(cases[a], cases[b]); });
+    return out;
 }
 
 // ===========================================================
@@ -84,166 +211,496 @@ int EmergencyDepartment::getValidatedInput(int min, int max, string prompt) {
 }
 
 // ===========================================================
-// Helper: Sort Cases by Priority (Ascending Order)
+// Heap Helpers — Binary Min-Heap on (triageKey, arrivalSeq)
 // ===========================================================
-// Simple bubble sort: O(n²) worst case (acceptable for ≤100 records).
-void EmergencyDepartment::sortCases() {
-    for (int i = 0; i < size - 1; i++) {
-        for (int j = 0; j < size - i - 1; j++) {
-            if (cases[j].priority > cases[j + 1].priority)
-                swap(cases[j], cases[j + 1]);
-        }
+// Children of node i live at 2i+1 and 2i+2. heapPos mirrors every
+// move so a case can be found by patientID in O(1) for decrease-key.
+bool EmergencyDepartment::comesBefore(const TriageEntry& a, const TriageEntry& b) {
+    if (a.triageKey != b.triageKey) return a.triageKey < b.triageKey;
+    return a.arrivalSeq < b.arrivalSeq;   // FIFO among equal effective priorities
+}
+
+// The key only depends on the case and the policy, never on "now": as time passes every case ages
+// at the same rate, so the relative order (and the heap) stays valid without being touched.
+void EmergencyDepartment::rekey(TriageEntry& e) const {
+    if (e.arrivalTime == 0) e.arrivalTime = static_cast<long long>(time(nullptr));
+    long long scale = aging.secondsPerLevel > 0 ? aging.secondsPerLevel : STRICT_SPAN;
+    e.triageKey = e.priority * scale + e.arrivalTime;
+}
+
+void EmergencyDepartment::swapCases(int i, int j) {
+    swap(cases[i], cases[j]);
+    heapPos[cases[i].patientID] = i;
+    heapPos[cases[j].patientID] = j;
+}
+
+void EmergencyDepartment::siftUp(int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!comesBefore(cases[i], cases[parent])) break;
+        swapCases(i, parent);
+        i = parent;
+    }
+}
+
+void EmergencyDepartment::siftDown(int i) {
+    while (true) {
+        int left = 2 * i + 1;
+        int right = left + 1;
+        int best = i;
+        if (left < cases.size() && comesBefore(cases[left], cases[best])) best = left;
+        if (right < cases.size() && comesBefore(cases[right], cases[best])) best = right;
+        if (best == i) break;
+        swapCases(i, best);
+        i = best;
+    }
+}
+
+// Bottom-up build: O(n) — used after bulk loads instead of sorting.
+void EmergencyDepartment::heapify() {
+    heapPos.clear();
+    byNameKey.clear();
+    byTypeKey.clear();
+    caseKeys.clear();
+    for (int i = 0; i < cases.size(); i++) {
+        rekey(cases[i]);
+        heapPos[cases[i].patientID] = i;
+        indexCase(cases[i]);
+    }
+    for (int i = cases.size() / 2 - 1; i >= 0; i--) siftDown(i);
+    Metrics::setGauge(Metrics::TRIAGE_HEAP, cases.size());
+}
+
+// Cases keep their text in the shared registry; a case imported from an admission shares the
+// admission's record (while it is still queued) instead of interning a second one. Cases logged in
+// the ED get a record of their own; cases from older files (admission unknown) try their case ID,
+// which older imports took from the admission.
+TriageEntry EmergencyDepartment::entryFor(const EmergencyCase& c, PatientRegistry::Handle record) {
+    TriageEntry e;
+    e.patientID = c.patientID;
+    e.admissionID = c.admissionID;
+    e.priority = c.priority;
+    e.arrivalSeq = c.arrivalSeq;
+    e.arrivalTime = c.arrivalTime;
+    e.patient = record != PatientRegistry::NONE ? record
+                                                : registry.share(c.admissionID != 0 ? c.admissionID : c.patientID,
+                                                                 c.patientName, c.emergencyType);
+    return e;
+}
+
+void EmergencyDepartment::copyOut(const TriageEntry& e, EmergencyCase& out) const {
+    PatientRegistry::Entry r = registry.get(e.patient);
+    out.patientID = e.patientID;
+    out.patientName.assign(r.name.data(), r.name.size());
+    out.emergencyType.assign(r.condition.data(), r.condition.size());
+    out.priority = e.priority;
+    out.arrivalSeq = e.arrivalSeq;
+    out.arrivalTime = e.arrivalTime;
+    out.triageKey = e.triageKey;
+    out.admissionID = e.admissionID;
+}
+
+bool EmergencyDepartment::pushCase(TriageEntry e) {
+    e.arrivalSeq = nextSeq++;
+    rekey(e);
+    heapPos[e.patientID] = cases.size();
+    indexCase(e);
+    cases.push_back(e);
+    siftUp(cases.size() - 1);
+    Metrics::setGauge(Metrics::TRIAGE_HEAP, cases.size());
+    return true;
+}
+
+bool EmergencyDepartment::popCase(EmergencyCase& out) {
+    if (cases.size() == 0) return false;
+    copyOut(cases[0], out);
+    registry.release(cases[0].patient);
+    heapPos.erase(out.patientID);
+    unindexCase(out.patientID);
+    int last = cases.size() - 1;
+    if (last > 0) {
+        cases[0] = cases[last];
+        heapPos[cases[0].patientID] = 0;
+    }
+    cases.pop_back();
+    if (!cases.empty()) siftDown(0);
+    Metrics::setGauge(Metrics::TRIAGE_HEAP, cases.size());
+    return true;
+}
+
+// Remove the case at any heap position: move last into the hole, re-sift.
+void EmergencyDepartment::removeAt(int index) {
+    registry.release(cases[index].patient);
+    heapPos.erase(cases[index].patientID);
+    unindexCase(cases[index].patientID);
+    int last = cases.size() - 1;
+    if (index != last) {
+        cases[index] = cases[last];
+        heapPos[cases[index].patientID] = index;
+    }
+    cases.pop_back();
+    if (index < cases.size()) {
+        int movedId = cases[index].patientID;
+        siftUp(index);
+        siftDown(heapPos[movedId]);
+    }
+    Metrics::setGauge(Metrics::TRIAGE_HEAP, cases.size());
+}
+
+// Decrease-key (or increase-key): re-position only the changed case.
+void EmergencyDepartment::changePriority(int index, int newPriority) {
+    long long old = cases[index].triageKey;
+    cases[index].priority = newPriority;
+    rekey(cases[index]);   // Keeps its arrival time: the wait so far still counts
+    if (cases[index].triageKey < old) siftUp(index);
+    else if (cases[index].triageKey > old) siftDown(index);
+}
+
+// ===========================================================
+// Triage-Order Cursor (Top-k Without Sorting)
+// ===========================================================
+// The next case in triage order is always the best one in the frontier: the children of the
+// cases already visited (heap order guarantees nothing else can beat them).
+EmergencyDepartment::TriageCursor::TriageCursor(const EmergencyDepartment& department)
+    : ed(department), current(-1) {
+    if (ed.cases.size() > 0) frontier.push_back(0);
+}
+
+const TriageEntry* EmergencyDepartment::TriageCursor::next() {
+    if (frontier.empty()) return nullptr;
+    auto later = [this](int a, int b) { return comesBefore(ed.cases[b], ed.cases[a]); };   // Min-heap
+    pop_heap(frontier.begin(), frontier.end(), later);
+    current = frontier.back();
+    frontier.pop_back();
+    for (int child = 2 * current + 1; child <= 2 * current + 2 && child < ed.cases.size(); ++child) {
+        frontier.push_back(child);
+        push_heap(frontier.begin(), frontier.end(), later);
     }
+    return &ed.cases[current];
 }
 
 // ===========================================================
-// Helper: Generate Next Available Unique ID
+// Helper: ID Allocator (Seeded Once, O(1) Amortised)
 // ===========================================================
-// Reads all IDs from "emergency.txt" to ensure no duplication.
-int EmergencyDepartment::generateNextID() {
-    unordered_set<int> existingIDs;
-    ifstream file("data/emergency.txt");
-    string line;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string idStr;
-        if (getline(ss, idStr, ',')) {
-            try {
-                existingIDs.insert(stoi(idStr));
-            } catch (...) {}
-        }
+// Same policy as before — lowest ID not used by a pending or a
+// processed (tombstoned) case — but computed once at startup.
+// Gaps below nextID sit in a min-heap free list; entries that get
+// taken later (e.g. a replayed or imported ID) are skipped lazily.
+// No extra file: every issued ID is already durable in an L / X
+// journal record, so the allocator is rebuilt from them on replay.
+void EmergencyDepartment::seedIDAllocator() {
+    int maxID = 0;
+    for (const auto& entry : heapPos) maxID = max(maxID, entry.first);
+    for (int id : retiredIds) maxID = max(maxID, id);
+
+    freeIDs.clear();
+    for (int id = 1; id <= maxID; id++) {
+        if (!heapPos.count(id) && !retiredIds.count(id)) freeIDs.push_back(id);
     }
-    file.close();
+    make_heap(freeIDs.begin(), freeIDs.end(), greater<int>());
+    nextID = maxID + 1;
+}
+
+void EmergencyDepartment::releaseID(int id) {
+    freeIDs.push_back(id);
+    push_heap(freeIDs.begin(), freeIDs.end(), greater<int>());
+}
 
-    int newID = 1;
-    while (existingIDs.find(newID) != existingIDs.end()) {
-        newID++;
+int EmergencyDepartment::generateNextID() {
+    while (!freeIDs.empty()) {
+        pop_heap(freeIDs.begin(), freeIDs.end(), greater<int>());
+        int id = freeIDs.back();
+        freeIDs.pop_back();
+        if (!heapPos.count(id) && !retiredIds.count(id)) return id;
     }
-    return newID;
+    while (heapPos.count(nextID) || retiredIds.count(nextID)) nextID++;
+    return nextID++;
 }
 
 // ===========================================================
 // Load Existing Emergency Cases
 // ===========================================================
-// Reads "data/emergency.txt" and fills local array. Each line =
-// ID, Name, Type, Priority. Then sorts by priority for processing.
+// Reads "data/emergency.txt" (EmergencyCaseLayout rows) and fills local
+// array. File order = arrival order; heapified once.
+// "data/emergency.bin" is used instead when it is at least as new.
 void EmergencyDepartment::loadExistingEmergencies() {
-    ifstream file("data/emergency.txt");
-    if (!file.is_open()) {
-        cout << "[!] No existing emergency data found.\n";
+    Metrics::Timer timer(Metrics::LOAD_EMERGENCY);
+    if (BinarySnapshot::preferBinary(EMERGENCY_BIN, EMERGENCY_FILE) && loadBinarySnapshot()) return;
+
+    MappedFile file;
+    if (!file.open(EMERGENCY_FILE)) {
+        Log::status() << "[!] No existing emergency data found.\n";
         return;
     }
 
-    string line;
+    CsvLineReader lines(file.view());
+    string_view line;
     int count = 0;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string idStr, name, type, priorityStr;
-
-        if (getline(ss, idStr, ',') &&
-            getline(ss, name, ',') &&
-            getline(ss, type, ',') &&
-            getline(ss, priorityStr, ',')) {
-
-            EmergencyCase temp;
-            temp.patientID = stoi(idStr);
-            temp.patientName = name;
-            temp.emergencyType = type;
-            temp.priority = stoi(priorityStr);
-
-            if (size < 100) {
-                cases[size++] = temp;
-                count++;
-            }
+    EmergencyCase temp;
+    while (lines.nextLine(line)) {
+        if (EmergencyCaseLayout::parseCsv(line, temp)) {
+            temp.arrivalSeq = nextSeq++;
+            cases.push_back(entryFor(temp));
+            count++;
         }
     }
-    file.close();
-    sortCases();
-    cout << "[✓] Loaded " << count << " existing emergency cases.\n";
+    heapify();
+    Log::status() << "[✓] Loaded " << count << " existing emergency cases.\n";
+}
+
+// Binary snapshot, columns from EmergencyCaseLayout: ints {id, priority, arrival hi, arrival lo},
+// strings {name, type}; arrival order.
+bool EmergencyDepartment::loadBinarySnapshot() {
+    BinarySnapshot::Reader snap;
+    if (!snap.open(EMERGENCY_BIN, BinarySnapshot::EMERGENCY, EmergencyCaseLayout::INT_COLUMNS,
+                   EmergencyCaseLayout::STR_COLUMNS)) return false;
+
+    cases.reserve(snap.count());
+    EmergencyCase temp;
+    for (uint32_t r = 0; r < snap.count(); r++) {
+        EmergencyCaseLayout::readFrom(snap, r, temp);
+        temp.arrivalSeq = nextSeq++;
+        cases.push_back(entryFor(temp));
+    }
+    heapify();
+    Log::status() << "[✓] Loaded " << snap.count() << " existing emergency cases.\n";
+    return true;
+}
+
+static bool writeBinarySnapshot(const vector<EmergencyCase>& live) {
+    BinarySnapshot::Writer snap(BinarySnapshot::EMERGENCY, EmergencyCaseLayout::INT_COLUMNS,
+                                EmergencyCaseLayout::STR_COLUMNS);
+    snap.reserve(live.size());
+    for (const EmergencyCase& c : live) EmergencyCaseLayout::addTo(snap, c);
+    return snap.writeTo(EMERGENCY_BIN);
+}
+
+// Files written before cases carried an admission ID imported a patient under its admission ID:
+// a pending case with that ID, an unknown admission and the same text is this patient's case.
+bool EmergencyDepartment::isLegacyImport(const EmergencyCase& row) const {
+    auto it = heapPos.find(row.admissionID);
+    if (it == heapPos.end() || cases[it->second].admissionID != 0) return false;
+    PatientRegistry::Entry r = registry.get(cases[it->second].patient);
+    return r.name == row.patientName && r.condition == row.emergencyType;
 }
 
 // ===========================================================
-// Load Patients from "patients.txt" (Avoid Duplicates)
+// Resync Patients from "patients.txt" (Avoid Duplicates)
 // ===========================================================
-// Reads from patient list, only imports those not already in
-// emergency.txt. Default priority = 6 (low urgency).
+// On demand only (admissions normally arrive over the event bus): picks up
+// patients admitted while the department was not running. Imports those
+// whose admission has no pending or processed case, each under a new case
+// ID. Default priority = 6 (low urgency).
 void EmergencyDepartment::loadPatientsFromFile() {
-    ifstream file("data/patients.txt");
-    if (!file.is_open()) {
-        cout << "[!] patients.txt not found. Skipping new patient import.\n";
+    drainIntake();   // Dedup against everything already submitted
+    MappedFile file;
+    if (!file.open("data/patients.txt")) {
+        Log::status() << "[!] patients.txt not found. Skipping new patient import.\n";
         return;
     }
 
-    unordered_set<int> existingIDs;
-    for (int i = 0; i < size; i++) {
-        existingIDs.insert(cases[i].patientID);
+    unordered_set<int> existingIDs;   // Admission IDs already triaged (processed patients stay processed)
+    for (int id : retiredIds) {
+        auto a = admittedAs.find(id);
+        int admission = a == admittedAs.end() ? 0 : a->second;
+        if (admission > 0) existingIDs.insert(admission);
+        else if (admission == 0) existingIDs.insert(id);   // Unknown (older files): imports kept the admission ID
+    }
+    for (int i = 0; i < cases.size(); i++) {
+        if (cases[i].admissionID > 0) existingIDs.insert(cases[i].admissionID);
     }
 
-    string line;
-    int newCount = 0;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string idStr, name, type;
-        if (getline(ss, idStr, ',') && getline(ss, name, ',') && getline(ss, type, ',')) {
-            int pid = stoi(idStr);
-            if (existingIDs.find(pid) == existingIDs.end()) {
-                EmergencyCase temp;
-                temp.patientID = pid;
-                temp.patientName = name;
-                temp.emergencyType = type;
-                temp.priority = 6;
-
-                if (size < 100) {
-                    cases[size++] = temp;
-                    saveCaseToFile(temp);
-                    existingIDs.insert(pid);
-                    newCount++;
-                }
-            }
+    // Batch pipeline: collect new cases + their L records, then one buffered
+    // journal append and one heapify for the whole import.
+    CsvLineReader lines(file.view());
+    string_view line;
+    vector<string> records;
+    EmergencyCase temp;
+    while (lines.nextLine(line)) {
+        if (AdmissionRowLayout::parseCsv(line, temp) && !temp.emergencyType.empty() &&
+            existingIDs.find(temp.admissionID) == existingIDs.end() && !isLegacyImport(temp)) {
+            temp.patientID = generateNextID();
+            temp.priority = 6;
+            temp.arrivalSeq = nextSeq++;
+            temp.arrivalTime = static_cast<long long>(time(nullptr));
+
+            records.push_back(caseRecord(temp));
+            existingIDs.insert(temp.admissionID);
+            heapPos[temp.patientID] = cases.size();   // Reserves the ID; heapify() rebuilds positions
+            cases.push_back(entryFor(temp));   // Shares the queue's record while the patient is still admitted
         }
     }
+    int newCount = static_cast<int>(records.size());
 
-    file.close();
-    sortCases();
-    cout << "[✓] Added " << newCount << " new unique patients from patients.txt.\n";
+    if (newCount > 0) {
+        if (!journal.appendBatch(records)) Log::error() << "[!] Could not write emergency.log.\n";
+        heapify();
+    }
+    Log::status() << "[✓] Added " << newCount << " new unique patients from patients.txt.\n";
 }
 
 // ===========================================================
-// Save Single Case to File (Append Mode)
+// Save Single Case (Journal Append)
 // ===========================================================
+string EmergencyDepartment::caseRecord(const EmergencyCase& c) {
+    string record = "L,";
+    EmergencyCaseLayout::appendCsv(record, c);
+    return record;
+}
+
 void EmergencyDepartment::saveCaseToFile(const EmergencyCase& newCase) {
-    ofstream file("data/emergency.txt", ios::app);
-    if (!file.is_open()) {
-        cout << "[!] Could not open emergency.txt for writing.\n";
+    logOperation(caseRecord(newCase));
+}
+
+// ===========================================================
+// Incremental Persistence — Journal + Background Compaction
+// ===========================================================
+// Record formats (all idempotent, keyed by case ID):
+//   L,<id>,<name>,<type>,<priority>[,<arrival>[,<admission>]]   new pending case (arrival: wall-clock
+//                                     seconds; admission: Role 1 patient ID, -1 = logged in the ED,
+//                                     0 / absent = unknown)
+//   U,<id>,<priority>                 priority update
+//   X,<id>[,<admission>]              processed (tombstone; admission as in L)
+//   D,<id>,<ambulanceId>              processed case was dispatched to that unit
+void EmergencyDepartment::logOperation(const string& entry) {
+    if (!journal.append(entry)) {
+        Log::error() << "[!] Could not write emergency.log.\n";
+        return;
+    }
+    if (journal.needsCompaction()) startCompaction();
+}
+
+void EmergencyDepartment::applyJournalEntry(string_view entry) {
+    if (entry.size() > 2 && entry[0] == 'L' && entry[1] == ',') {
+        EmergencyCase c;   // Arrival absent in older journals: stamped by pushCase
+        if (!EmergencyCaseLayout::parseCsv(entry.substr(2), c)) return;
+        if (heapPos.count(c.patientID) || retiredIds.count(c.patientID)) return;   // Already applied
+        pushCase(entryFor(c));
         return;
     }
-    file << newCase.patientID << "," << newCase.patientName << ","
-         << newCase.emergencyType << "," << newCase.priority << endl;
-    file.close();
+
+    CsvTokenizer tok(entry);
+    string_view op, idField;
+    int id;
+    if (!tok.next(op) || !tok.next(idField) || !parseIntField(idField, id)) return;
+
+    if (op == "U") {
+        string_view priorityField;
+        int priority;
+        auto it = heapPos.find(id);
+        if (it == heapPos.end() || !tok.next(priorityField) || !parseIntField(priorityField, priority)) return;
+        changePriority(it->second, priority);
+    } else if (op == "X") {
+        string_view admissionField;
+        int admission;
+        if (tok.next(admissionField) && parseIntField(admissionField, admission)) admittedAs[id] = admission;
+        auto it = heapPos.find(id);
+        if (it != heapPos.end()) removeAt(it->second);
+        retiredIds.insert(id);
+        retiredPending.push_back(id);   // The row may not have reached the retired file (re-appending is harmless)
+    } else if (op == "D") {
+        string_view unitField;
+        int unit;
+        if (tok.next(unitField) && parseIntField(unitField, unit)) {
+            dispatchedTo[id] = unit;
+            retiredPending.push_back(id);
+        }
+    }
+}
+
+// Rows ID[,unit[,admission]] (0 = none / unknown; older builds: ID[,unit]). The file is append-only
+// like a journal: a case is appended when it is retired and again when it is dispatched, so the
+// last row of an ID wins, and a torn final row is cut.
+void EmergencyDepartment::loadRetiredIds() {
+    retiredLog.replay([this](string_view line) {
+        CsvTokenizer tok(line);
+        string_view field;
+        int id, unit, admission;
+        if (!tok.next(field) || !parseIntField(field, id)) return;
+        retiredIds.insert(id);
+        if (!tok.next(field)) return;
+        if (parseIntField(field, unit) && unit > 0) dispatchedTo[id] = unit;
+        if (tok.next(field) && parseIntField(field, admission)) admittedAs[id] = admission;
+    });
+}
+
+// Copies live state (O(n), amortised over Journal::COMPACT_EVERY operations),
+// rotates the journal so new records keep flowing, and writes the snapshot
+// on a worker thread. The worker only touches its own copies and files.
+// Retired cases are not rewritten: only rows retired or dispatched since the
+// last compaction are appended, so the cost does not grow with history.
+void EmergencyDepartment::startCompaction() {
+    waitForCompaction();
+
+    vector<EmergencyCase> live(cases.size());   // Text copied out of the registry for the worker
+    for (int i = 0; i < cases.size(); i++) copyOut(cases[i], live[i]);
+    // Snapshot in arrival order so a reload keeps the FIFO tie-break.
+    sort(live.begin(), live.end(), [](const EmergencyCase& a, const EmergencyCase& b) {
+        return a.arrivalSeq < b.arrivalSeq;
+    });
+    sort(retiredPending.begin(), retiredPending.end());   // Retired and dispatched since: one row
+    retiredPending.erase(unique(retiredPending.begin(), retiredPending.end()), retiredPending.end());
+    vector<string> retired;   // id,unit,admission (0 = none / unknown)
+    retired.reserve(retiredPending.size());
+    for (int id : retiredPending) {
+        auto d = dispatchedTo.find(id);
+        auto a = admittedAs.find(id);
+        retired.push_back(to_string(id) + "," + to_string(d == dispatchedTo.end() ? 0 : d->second) + "," +
+                          to_string(a == admittedAs.end() ? 0 : a->second));
+    }
+
+    if (!journal.rotate(EMERGENCY_ARCHIVE)) return;   // Keep journaling; retry next time
+    retiredInFlight.swap(retiredPending);
+    retiredPending.clear();
+    compactionOk = false;
+
+    compactor = thread([this, live = std::move(live), retired = std::move(retired)]() {
+        Metrics::Timer timer(Metrics::SAVE_EMERGENCY);   // CSV + retired + binary, off the caller's thread
+        string tmp = string(EMERGENCY_FILE) + ".tmp";
+        ofstream out(tmp);
+        for (const EmergencyCase& c : live) {
+            EmergencyCaseLayout::writeCsv(out, c);
+            out << '\n';
+        }
+        out.close();
+
+        // Archive is dropped only after both files are safely in place (retired rows synced).
+        if (out.good() && retiredLog.appendBatch(retired) &&
+            Journal::replaceFile(tmp, EMERGENCY_FILE)) {
+            writeBinarySnapshot(live);   // After the CSV, so the .bin is the newer file
+            remove(EMERGENCY_ARCHIVE);
+            compactionOk = true;
+        }
+    });
+}
+
+void EmergencyDepartment::waitForCompaction() {
+    if (!compactor.joinable()) return;
+    compactor.join();
+    if (!compactionOk) {   // The archive stays; its rows go out with the next compaction
+        retiredPending.insert(retiredPending.end(), retiredInFlight.begin(), retiredInFlight.end());
+    }
+    retiredInFlight.clear();
 }
 
 // ===========================================================
-// Log a New Emergency Case (Insert + Sort)
+// Log a New Emergency Case (Heap Insert)
 // ===========================================================
 // Prompts user for emergency details, assigns auto ID, sets
-// priority (1=critical, 10=least). Re-sorts array afterward.
+// priority (1=critical, 10=least). Sifts into place: O(log n).
 void EmergencyDepartment::logEmergencyCase() {
-    if (size >= 100) {
-        cout << "\n[!] Maximum case limit reached.\n";
-        return;
-    }
-
     EmergencyCase newCase;
     cout << "\n--- Log New Emergency Case ---\n";
 
     newCase.patientID = generateNextID();
-    cout << "[Auto Assigned] Patient ID: " << newCase.patientID << endl;
+    cout << "[Auto Assigned] Patient ID: " << newCase.patientID << "\n";
 
     cin.ignore();
     cout << "Enter Patient Name: ";
     getline(cin, newCase.patientName);
     if (newCase.patientName.empty()) {
         cout << "[!] Name cannot be empty.\n";
+        releaseID(newCase.patientID);
         return;
     }
 
@@ -252,7 +709,7 @@ void EmergencyDepartment::logEmergencyCase() {
         cout << "\nSelect Type of Emergency:\n";
         cout << "1. Heart Attack\n2. Road Accident\n3. Asthma Attack\n4. Severe Burn\n5. Other\n";
         int typeChoice = getValidatedInput(1, 5, "Enter your choice (1-5): ");
-        if (typeChoice == -1) return;
+        if (typeChoice == -1) { releaseID(newCase.patientID); return; }
 
         switch (typeChoice) {
             case 1: newCase.emergencyType = "Heart Attack"; newCase.priority = 1; break;
@@ -263,77 +720,342 @@ void EmergencyDepartment::logEmergencyCase() {
                 cout << "Enter Custom Type: ";
                 getline(cin, newCase.emergencyType);
                 newCase.priority = getValidatedInput(1, 10, "Enter Priority Level (1=Critical): ");
-                if (newCase.priority == -1) return;
+                if (newCase.priority == -1) { releaseID(newCase.patientID); return; }
                 break;
         }
         break;
     }
 
-    // Insert into array by shifting larger priorities right
-    int i = size - 1;
-    while (i >= 0 && cases[i].priority > newCase.priority) {
-        cases[i + 1] = cases[i];
-        i--;
+    newCase.arrivalTime = static_cast<long long>(time(nullptr));   // Journaled, so the wait survives restarts
+    newCase.admissionID = EmergencyCase::NOT_ADMITTED;
+    {
+        Metrics::Timer timer(Metrics::LOG_EMERGENCY);   // Insert + journal only, not the prompts
+        pushCase(entryFor(newCase));
+        saveCaseToFile(newCase);
     }
-    cases[i + 1] = newCase;
-    size++;
-
-    saveCaseToFile(newCase);
     cout << "\n[+] Emergency case logged and saved!\n";
 }
 
 // ===========================================================
-// Process the Most Critical Case (Dequeue Front)
+// Headless Entry Points (batch mode: no prompts)
+// ===========================================================
+// Priority of the built-in emergency types (menu choices 1-4); 0 if the type is custom.
+int EmergencyDepartment::standardPriority(const string& type) {
+    static const char* const types[] = { "heart attack", "road accident", "asthma attack", "severe burn" };
+    string key;
+    lowerInto(type, key);
+    for (int i = 0; i < 4; ++i) {
+        if (key == types[i]) return i + 1;
+    }
+    return 0;
+}
+
+// Logs a case without prompting. priority 0 = derive from a built-in type. Returns the ID, or -1.
+int EmergencyDepartment::logCase(const string& name, const string& type, int priority) {
+    drainIntake();   // Earlier submissions arrive first (timed as DRAIN_INTAKE, not here)
+    Metrics::Timer timer(Metrics::LOG_EMERGENCY);
+    if (priority == 0) priority = standardPriority(type);
+    if (name.empty() || type.empty() || priority < 1 || priority > 10) return -1;
+
+    EmergencyCase c;
+    c.patientID = generateNextID();
+    c.patientName = name;
+    c.emergencyType = type;
+    c.priority = priority;
+    c.arrivalTime = static_cast<long long>(time(nullptr));
+    c.admissionID = EmergencyCase::NOT_ADMITTED;
+    pushCase(entryFor(c));
+    saveCaseToFile(c);
+    return c.patientID;
+}
+
+// Decrease/increase-key by patient ID (O(log n) via heapPos). False if the case is not pending.
+bool EmergencyDepartment::setPriority(int patientID, int newPriority) {
+    drainIntake();
+    Metrics::Timer timer(Metrics::UPDATE_PRIORITY);
+    auto it = heapPos.find(patientID);
+    if (it == heapPos.end() || newPriority < 1 || newPriority > 10) return false;
+    logOperation("U," + to_string(patientID) + "," + to_string(newPriority));
+    changePriority(it->second, newPriority);
+    return true;
+}
+
+// ===========================================================
+// Lock-Free Intake (MPSC queue -> heap)
+// ===========================================================
+// Producers only allocate and link a node; the heap, indexes, ID allocator and journal are
+// touched by the single consumer in drainIntake().
+bool EmergencyDepartment::submitCase(EmergencyCase c) {
+    if (c.priority == 0) c.priority = standardPriority(c.emergencyType);
+    if (c.patientName.empty() || c.emergencyType.empty() || c.priority < 1 || c.priority > 10) return false;
+    if (c.arrivalTime == 0) c.arrivalTime = static_cast<long long>(time(nullptr));   // The wait starts now
+    if (c.admissionID == 0) c.admissionID = EmergencyCase::NOT_ADMITTED;
+    intake.push({std::move(c), PatientRegistry::NONE, chrono::steady_clock::now()});
+    Metrics::setGauge(Metrics::TRIAGE_INTAKE, intake.depth());
+    return true;
+}
+
+// Drain everything queued, in submission order. A batch at least as large as the heap is appended
+// and heapified in O(n + k); smaller batches are sifted in, O(k log n). One journal write either way (fsync batched).
+int EmergencyDepartment::drainIntake() {
+    Metrics::Timer timer(Metrics::DRAIN_INTAKE);
+    static const size_t WAIT_SAMPLES = 4096;
+    IntakeItem item;
+    vector<IntakeItem> batch;
+    while (intake.pop(item)) batch.push_back(std::move(item));
+    Metrics::setGauge(Metrics::TRIAGE_INTAKE, intake.depth());
+    if (batch.empty()) return 0;
+
+    auto now = chrono::steady_clock::now();
+    bool bulk = batch.size() >= static_cast<size_t>(cases.size());
+    vector<string> records;
+    records.reserve(batch.size());
+    for (IntakeItem& it : batch) {
+        EmergencyCase& c = it.c;
+        if (c.patientID > 0) {   // Caller-chosen ID (admissions and submit-emergency take ED IDs below)
+            if (heapPos.count(c.patientID) || retiredIds.count(c.patientID)) {
+                Log::error() << "[!] Intake: case ID " << c.patientID << " is already in use; case dropped.\n";
+                registry.release(it.patient);
+                continue;
+            }
+        } else {
+            c.patientID = generateNextID();
+        }
+        if (c.arrivalTime == 0) c.arrivalTime = static_cast<long long>(time(nullptr));
+        if (it.patient != PatientRegistry::NONE) {   // Admission: the journal record needs the text
+            PatientRegistry::Entry r = registry.get(it.patient);
+            c.patientName.assign(r.name.data(), r.name.size());
+            c.emergencyType.assign(r.condition.data(), r.condition.size());
+        }
+        TriageEntry e = entryFor(c, it.patient);
+        records.push_back(caseRecord(c));
+        if (bulk) {
+            e.arrivalSeq = nextSeq++;
+            heapPos[e.patientID] = cases.size();   // Reserves the ID; heapify() rebuilds positions
+            cases.push_back(e);
+        } else {
+            pushCase(e);
+        }
+
+        long long waited = chrono::duration_cast<chrono::microseconds>(now - it.submittedAt).count();
+        if (intakeWaits.size() < WAIT_SAMPLES) intakeWaits.push_back(waited);
+        else intakeWaits[intakeWaitNext] = waited;
+        intakeWaitNext = (intakeWaitNext + 1) % WAIT_SAMPLES;
+    }
+    if (bulk) heapify();
+    // fsync batched like single appends (SYNC_EVERY): no disk sync per drain under the heap lock
+    if (!records.empty() && !journal.appendBatch(records, Journal::BATCHED)) {
+        Log::error() << "[!] Could not write emergency.log.\n";
+    }
+    return static_cast<int>(records.size());
+}
+
+long long EmergencyDepartment::intakeWaitUs(double percentile) const {
+    return percentileOf(intakeWaits, percentile);
+}
+
+// Nearest-rank percentile of a sample ring (0 if empty). O(n) selection on a copy.
+long long EmergencyDepartment::percentileOf(const vector<long long>& samples, double percentile) {
+    if (samples.empty()) return 0;
+    vector<long long> sorted(samples);
+    size_t rank = static_cast<size_t>(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+    nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+// ===========================================================
+// Priority Aging (starvation avoidance)
 // ===========================================================
-// Removes and displays top-priority case (smallest priority value).
+// Effective priority = priority - waited / secondsPerLevel (never below 1). Computed for display
+// only; the heap order already reflects it through triageKey.
+int EmergencyDepartment::effectivePriority(const EmergencyCase& c, long long now) const {
+    if (aging.secondsPerLevel <= 0 || now <= c.arrivalTime) return c.priority;
+    long long levels = (now - c.arrivalTime) / aging.secondsPerLevel;
+    return static_cast<int>(max<long long>(1, c.priority - levels));
+}
+
+void EmergencyDepartment::loadAgingPolicy() {
+    ifstream in(POLICY_FILE);
+    if (!in) return;   // Defaults
+    string line;
+    while (getline(in, line)) {
+        string_view v = trimView(line);
+        if (v.empty() || v[0] == '#') continue;
+        size_t eq = v.find('=');
+        if (eq == string_view::npos) continue;
+        int value;
+        if (trimView(v.substr(0, eq)) == "seconds_per_level" && parseIntField(v.substr(eq + 1), value) && value >= 0) {
+            aging.secondsPerLevel = value;
+        }
+    }
+    if (aging.secondsPerLevel > 0) {
+        Log::status() << "[✓] Triage aging: one priority level per " << aging.secondsPerLevel << "s of waiting.\n";
+    } else {
+        Log::status() << "[✓] Triage aging disabled (strict priority).\n";
+    }
+}
+
+// Re-keys every pending case under the new policy (O(n) heapify) and persists the policy.
+bool EmergencyDepartment::setAgingPolicy(const AgingPolicy& policy) {
+    if (policy.secondsPerLevel < 0) return false;
+    drainIntake();
+    aging = policy;
+    heapify();
+
+    string tmp = string(POLICY_FILE) + ".tmp";
+    {
+        ofstream out(tmp, ios::trunc);
+        if (!out) return false;
+        out << "# One priority level gained per this many seconds of waiting (0 = strict priority)\n"
+            << "seconds_per_level=" << aging.secondsPerLevel << "\n";
+        if (!out) return false;
+    }
+    return Journal::replaceFile(tmp, POLICY_FILE);
+}
+
+void EmergencyDepartment::recordServed(const EmergencyCase& c, long long now) {
+    int p = (c.priority >= 1 && c.priority <= 10) ? c.priority : 0;
+    long long waited = now > c.arrivalTime ? now - c.arrivalTime : 0;
+    vector<long long>& ring = servedWaits[p];
+    if (ring.size() < WAIT_SAMPLES_PER_LEVEL) ring.push_back(waited);
+    else ring[servedWaitNext[p]] = waited;
+    servedWaitNext[p] = (servedWaitNext[p] + 1) % WAIT_SAMPLES_PER_LEVEL;
+}
+
+// Wait (seconds, arrival -> processed) of recently served cases at the given original priority.
+long long EmergencyDepartment::waitPercentile(int priority, double percentile) const {
+    if (priority < 1 || priority > 10) return 0;
+    return percentileOf(servedWaits[priority], percentile);
+}
+
+void EmergencyDepartment::viewWaitTimes() const {
+    Log::result() << "\n--- Wait Times by Priority (last " << WAIT_SAMPLES_PER_LEVEL << " served per level) ---\n";
+    if (aging.secondsPerLevel > 0) {
+        Log::result() << "Aging: one level per " << aging.secondsPerLevel << "s of waiting.\n";
+    } else {
+        Log::result() << "Aging: off (strict priority).\n";
+    }
+    Log::result() << "-------------------------------------------------------\n"
+                  << "Priority | Served | p50 (s) | p90 (s) | p99 (s) | max (s)\n"
+                  << "-------------------------------------------------------\n";
+    bool any = false;
+    for (int p = 1; p <= 10; ++p) {
+        const vector<long long>& ring = servedWaits[p];
+        if (ring.empty()) continue;
+        any = true;
+        Log::result() << setw(8) << p << " | " << setw(6) << ring.size()
+                      << " | " << setw(7) << percentileOf(ring, 50)
+                      << " | " << setw(7) << percentileOf(ring, 90)
+                      << " | " << setw(7) << percentileOf(ring, 99)
+                      << " | " << setw(7) << *max_element(ring.begin(), ring.end()) << "\n";
+    }
+    if (!any) Log::result() << "(no cases processed this session)\n";
+    Log::result() << "-------------------------------------------------------\n";
+}
+
+// ===========================================================
+// Process the Most Critical Case (Heap Pop)
+// ===========================================================
+// Removes and displays the case with the lowest triage key (priority aged
+// by time waited; earliest arrival among ties). O(log n).
 void EmergencyDepartment::processCriticalCase() {
-    if (size == 0) {
-        cout << "\n[!] No emergency cases to process.\n";
+    EmergencyCase top;
+    if (!takeNextCase(top)) {
+        Log::error() << "\n[!] No emergency cases to process.\n";
         return;
     }
+    long long now = static_cast<long long>(time(nullptr));
+    int effective = effectivePriority(top, now);
 
-    cout << "\n--- Processing Most Critical Case ---\n";
-    cout << "Patient: " << cases[0].patientName
-         << " | Type: " << cases[0].emergencyType
-         << " | Priority: " << cases[0].priority << endl;
+    Log::result() << "\n--- Processing Most Critical Case ---\n"
+                  << "Patient: " << top.patientName
+                  << " | Type: " << top.emergencyType
+                  << " | Priority: " << top.priority;
+    if (effective != top.priority) {
+        Log::result() << " (effective " << effective << " after " << (now - top.arrivalTime) / 60 << " min)";
+    }
+    Log::result() << "\n[✓] Case processed and removed.\n";
+}
 
-    // Shift all cases forward
-    for (int i = 0; i < size - 1; i++)
-        cases[i] = cases[i + 1];
-    size--;
+// Pop + tombstone without any output (shared by option 2 and the dispatch engine). O(log n).
+bool EmergencyDepartment::takeNextCase(EmergencyCase& out) {
+    drainIntake();
+    Metrics::Timer timer(Metrics::PROCESS_CRITICAL);
+    if (!popCase(out)) return false;
+    recordServed(out, static_cast<long long>(time(nullptr)));
+    retiredIds.insert(out.patientID);
+    retiredPending.push_back(out.patientID);
+    admittedAs[out.patientID] = out.admissionID;   // A resync will not triage this admission again
+    logOperation("X," + to_string(out.patientID) + "," + to_string(out.admissionID));   // Tombstone: O(1) durable removal
+    return true;
+}
 
-    cout << "[✓] Case processed and removed.\n";
+// Attach the responding unit to a processed case (journaled; kept in the retired snapshot).
+bool EmergencyDepartment::recordDispatch(int patientID, int ambulanceId) {
+    if (!retiredIds.count(patientID) || ambulanceId <= 0) return false;
+    dispatchedTo[patientID] = ambulanceId;
+    retiredPending.push_back(patientID);
+    logOperation("D," + to_string(patientID) + "," + to_string(ambulanceId));
+    return true;
+}
+
+int EmergencyDepartment::dispatchedUnit(int patientID) const {
+    auto it = dispatchedTo.find(patientID);
+    return it == dispatchedTo.end() ? 0 : it->second;
 }
 
 // ===========================================================
 // View All Pending Cases
 // ===========================================================
-// Displays all cases in ascending order of priority.
+// Displays the cases in triage order (priority, then arrival), one page at a time.
 void EmergencyDepartment::viewPendingCases() {
-    if (size == 0) {
+    if (cases.size() == 0) {
         cout << "\n[!] No pending cases.\n";
         return;
     }
+    PagedView::browse([this](int offset, int limit) { return viewPendingCases(offset, limit); });
+}
+
+// One page: the cursor visits only the first offset + limit cases (O((offset + limit) log k)).
+bool EmergencyDepartment::viewPendingCases(int offset, int limit) const {
+    ostream& out = Log::result();
+    if (cases.size() == 0) {
+        out << "\n[!] No pending cases.\n";
+        return false;
+    }
+    if (offset >= cases.size()) {
+        PagedView::footer(out, offset, 0, cases.size(), false);
+        return false;
+    }
 
-    cout << "\n--- Pending Emergency Cases (By Priority) ---\n";
-    cout << "-----------------------------------------------------------\n";
-    cout << "No. | ID | Priority | Patient Name        | Emergency Type\n";
-    cout << "-----------------------------------------------------------\n";
+    out << "\n--- Pending Emergency Cases (By Priority) ---\n";
+    out << "-----------------------------------------------------------\n";
+    out << "No. | ID | Priority | Patient Name        | Emergency Type\n";
+    out << "-----------------------------------------------------------\n";
 
-    for (int i = 0; i < size; i++) {
-        cout << i + 1 << "   | " << cases[i].patientID
-             << "  | " << cases[i].priority
-             << "        | " << cases[i].patientName
-             << "        | " << cases[i].emergencyType << endl;
+    TriageCursor cursor(*this);
+    int rank = 0;
+    while (rank < offset && cursor.next()) rank++;
+    const TriageEntry* c = nullptr;
+    while (rank < offset + limit && (c = cursor.next())) {
+        PatientRegistry::Entry r = registry.get(c->patient);
+        out << ++rank << "   | " << c->patientID
+            << "  | " << c->priority
+            << "        | " << r.name
+            << "        | " << r.condition << "\n";
     }
-    cout << "-----------------------------------------------------------\n";
+    out << "-----------------------------------------------------------\n";
+    int shown = rank - offset;
+    bool more = offset + shown < cases.size();
+    PagedView::footer(out, offset, shown, cases.size(), more);
+    return more;
 }
 
 // ===========================================================
 // Search Functions (By Name / Type)
 // ===========================================================
 void EmergencyDepartment::searchByPatientName() {
-    if (size == 0) {
+    if (cases.size() == 0) {
         cout << "\n[!] No cases to search.\n";
         return;
     }
@@ -341,26 +1063,24 @@ void EmergencyDepartment::searchByPatientName() {
     string name;
     cout << "\nEnter Patient Name to Search: ";
     getline(cin, name);
-    string lowerName = toLowerCase(name);
 
-    bool found = false;
-    for (int i = 0; i < size; i++) {
-        if (toLowerCase(cases[i].patientName) == lowerName) {
-            cout << "\n[✓] Found Case:\n";
-            cout << "ID: " << cases[i].patientID
-                 << "\nName: " << cases[i].patientName
-                 << "\nType: " << cases[i].emergencyType
-                 << "\nPriority: " << cases[i].priority << endl;
-            found = true;
-        }
+    // O(1) average lookup of the interned key, then only the matching cases.
+    vector<int> matches = matchingCases(byNameKey, findKey(name));
+    for (int i : matches) {
+        PatientRegistry::Entry r = registry.get(cases[i].patient);
+        cout << "\n[✓] Found Case:\n";
+        cout << "ID: " << cases[i].patientID
+             << "\nName: " << r.name
+             << "\nType: " << r.condition
+             << "\nPriority: " << cases[i].priority << "\n";
     }
 
-    if (!found)
-        cout << "[!] No patient found with name: " << name << endl;
+    if (matches.empty())
+        cout << "[!] No patient found with name: " << name << "\n";
 }
 
 void EmergencyDepartment::searchByEmergencyType() {
-    if (size == 0) {
+    if (cases.size() == 0) {
         cout << "\n[!] No cases to search.\n";
         return;
     }
@@ -368,27 +1088,52 @@ void EmergencyDepartment::searchByEmergencyType() {
     string type;
     cout << "\nEnter Emergency Type to Search: ";
     getline(cin, type);
-    string lowerType = toLowerCase(type);
 
+    vector<int> matches = matchingCases(byTypeKey, findKey(type));
+    cout << "\n--- Matching Cases ---\n";
+    for (int i : matches) {
+        cout << "Patient: " << registry.get(cases[i].patient).name
+             << " | Priority: " << cases[i].priority << "\n";
+    }
+
+    if (matches.empty())
+        cout << "[!] No cases found for type: " << type << "\n";
+}
+
+void EmergencyDepartment::searchByTypePrefix() {
+    if (cases.size() == 0) {
+        cout << "\n[!] No cases to search.\n";
+        return;
+    }
+
+    string prefix;
+    cout << "\nEnter Emergency Type Prefix: ";
+    getline(cin, prefix);
+    lowerInto(prefix, queryKey);
+
+    // Ordered map: all types with the prefix are contiguous from lower_bound.
     bool found = false;
     cout << "\n--- Matching Cases ---\n";
-    for (int i = 0; i < size; i++) {
-        if (toLowerCase(cases[i].emergencyType) == lowerType) {
-            cout << "Patient: " << cases[i].patientName
-                 << " | Priority: " << cases[i].priority << endl;
+    for (auto it = typeOrder.lower_bound(queryKey);
+         it != typeOrder.end() && it->first.compare(0, queryKey.size(), queryKey) == 0; ++it) {
+        for (int i : matchingCases(byTypeKey, it->second)) {
+            PatientRegistry::Entry r = registry.get(cases[i].patient);
+            cout << "Patient: " << r.name
+                 << " | Type: " << r.condition
+                 << " | Priority: " << cases[i].priority << "\n";
             found = true;
         }
     }
 
     if (!found)
-        cout << "[!] No cases found for type: " << type << endl;
+        cout << "[!] No cases found for type prefix: " << prefix << "\n";
 }
 
 // ===========================================================
-// Update Case Priority (Reorder After Update)
+// Update Case Priority (Decrease-Key, O(log n))
 // ===========================================================
 void EmergencyDepartment::updatePriority() {
-    if (size == 0) {
+    if (cases.size() == 0) {
         cout << "\n[!] No cases available to update.\n";
         return;
     }
@@ -401,34 +1146,38 @@ void EmergencyDepartment::updatePriority() {
 
     bool found = false;
     if (method == 1) {
-        int num = getValidatedInput(1, size, "Enter Case Number to Update: ");
+        // Case numbers match the triage order shown by viewPendingCases()
+        int num = getValidatedInput(1, cases.size(), "Enter Case Number to Update: ");
         if (num == -1) return;
 
-        cout << "Selected: " << cases[num - 1].patientName << endl;
+        TriageCursor cursor(*this);
+        for (int n = 0; n < num; n++) cursor.next();
+        int idx = cursor.index();
+        cout << "Selected: " << registry.get(cases[idx].patient).name << "\n";
         int newP = getValidatedInput(1, 10, "Enter New Priority (1=Critical): ");
         if (newP == -1) return;
-        cases[num - 1].priority = newP;
+        logOperation("U," + to_string(cases[idx].patientID) + "," + to_string(newP));
+        changePriority(idx, newP);
         found = true;
     } else {
         string name;
         cout << "Enter Patient Name: ";
         getline(cin, name);
-        string lowerName = toLowerCase(name);
-
-        for (int i = 0; i < size; i++) {
-            if (toLowerCase(cases[i].patientName) == lowerName) {
-                cout << "Current Priority: " << cases[i].priority << endl;
-                int newP = getValidatedInput(1, 10, "Enter New Priority: ");
-                if (newP == -1) return;
-                cases[i].priority = newP;
-                found = true;
-                break;
-            }
+
+        // First match in triage order, via the name index (no scan).
+        vector<int> matches = matchingCases(byNameKey, findKey(name));
+        if (!matches.empty()) {
+            int idx = matches[0];
+            cout << "Current Priority: " << cases[idx].priority << "\n";
+            int newP = getValidatedInput(1, 10, "Enter New Priority: ");
+            if (newP == -1) return;
+            logOperation("U," + to_string(cases[idx].patientID) + "," + to_string(newP));
+            changePriority(idx, newP);
+            found = true;
         }
     }
 
     if (found) {
-        sortCases();
         cout << "[✓] Priority updated and list reordered.\n";
     } else {
         cout << "[!] Case not found.\n";
@@ -461,11 +1210,15 @@ void EmergencyDepartment::displayMenu() {
         cout << "4. Search by Patient Name\n";
         cout << "5. Search by Emergency Type\n";
         cout << "6. Update Case Priority\n";
-        cout << "7. Return to Main Menu\n";
+        cout << "7. Search by Emergency Type Prefix\n";
+        cout << "8. Import Admitted Patients (resync from patients.txt)\n";
+        cout << "9. Wait-Time Report\n";
+        cout << "10. Return to Main Menu\n";
         cout << "----------------------------------------------\n";
 
-        choice = askInput(1, 7, "Enter your choice (1-7): ");
+        choice = askInput(1, 10, "Enter your choice (1-10): ");
         if (choice == -1) continue;
+        drainIntake();   // Fold in cases other terminals / feeds submitted meanwhile
 
         switch (choice) {
             case 1: logEmergencyCase(); break;
@@ -474,8 +1227,11 @@ void EmergencyDepartment::displayMenu() {
             case 4: searchByPatientName(); break;
             case 5: searchByEmergencyType(); break;
             case 6: updatePriority(); break;
-            case 7: cout << "\nReturning to main menu...\n"; break;
+            case 7: searchByTypePrefix(); break;
+            case 8: loadPatientsFromFile(); break;
+            case 9: viewWaitTimes(); break;
+            case 10: cout << "\nReturning to main menu...\n"; break;
         }
 
-    } while (choice != 7);
+    } while (choice != 10);
 }
@@ -1,43 +1,120 @@
 // Emergency.hpp
 // Header for Role 3: Emergency Department.
-// Data Structure Choice: ARRAY + PRIORITY QUEUE
+// Data Structure Choice: ARRAY + PRIORITY QUEUE (indexed binary min-heap)
 // 
 // Why PRIORITY QUEUE (based on severity ranking)?
 // - Emergencies must be handled by *criticality*, not arrival order.
 // - Lower priority number = higher urgency (e.g., 1 = critical, 5 = mild).
-// - Patients are sorted automatically — ensures most severe cases processed first.
+// - Equal priorities are served in arrival order (FIFO tie-break on arrivalSeq).
+// - Aging (AgingPolicy): waiting improves a case's effective priority, so constant high-acuity
+//   load cannot starve priority-6 imports; encoded in a time-invariant key, no re-sorting.
 // - When processing: highest-priority case dequeued first (simulating triage system).
 //
-// Why ARRAY as underlying structure?
-// - Fixed size (MAX_CASES = 100) fits manageable emergency list.
-// - Simpler than dynamic/linked lists (faster cache access, minimal memory overhead).
-// - Sorting on insert (O(n)) is acceptable for small n=100.
-// - Predictable, efficient, and easily maintained for educational projects.
+// Why ARRAY-BACKED BINARY HEAP?
+// - Heap lives in the array itself (children of i at 2i+1, 2i+2) — contiguous, cache-friendly.
+// - Backing array is a ChunkedStore: no MAX_CASES cap, grows a chunk at a time, never moves cases.
+// - Push / pop / priority change are O(log n) instead of O(n) shifting + O(n²) re-sorting.
+// - Loading uses bottom-up heapify: O(n) for the whole file.
+// - Heap slots are compact TriageEntry records (keys + a PatientRegistry handle): names and types
+//   live once in the shared registry, and an admitted patient's case references the very record the
+//   admission queue holds, so sifts move 40-byte slots and no strings.
+// - A patientID -> heap position index makes updatePriority() a true decrease-key.
+// - Case-insensitive search indexes: lowercased name/type keys are interned once per distinct
+//   string and map to the IDs of matching cases, so name/type searches are O(1) average with
+//   no per-query allocation; an ordered type map serves prefix searches.
 //
 // Innovation:
 // - Auto-ID generation (no duplicate patient IDs).
-// - Auto-loading from patient records (avoids re-entry).
+// - Live link to admissions: subscribes to EventBus::patientAdmitted(), so a newly admitted
+//   patient is queued for triage immediately (no startup rescan of patients.txt). Every admission
+//   gets a case of its own: case IDs are issued by the ED, the admission ID is kept alongside
+//   (Role 1 reuses IDs once patients are discharged, so it cannot key triage).
 // - File I/O sync with "emergency.txt" for persistence.
+// - Incremental persistence: every log / process / priority change appends one record
+//   (L / X tombstone / U update) to "emergency.log"; a background thread folds the journal
+//   into "emergency.txt" so durability costs O(1) per triage decision.
+// - Lock-free intake: any thread (ambulance crews, desks, device feeds) can submitCase() into an
+//   MPSC queue without touching the heap; the triage side drains it in batches (IDs assigned,
+//   one journal write, one heapify when the batch is large), so producers never wait on the sort.
 //
 // Challenges Addressed:
 // - Triage fairness (priority-based order)
-// - Smooth integration with patient module (shared data files)
+// - Smooth integration with patient module (event bus; patients.txt resync on request)
 // - Safe user input validation
 
 #ifndef EMERGENCY_HPP
 #define EMERGENCY_HPP
 
+#include <chrono>
+#include <functional>
+#include <map>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
+#include "ChunkedStore.hpp"
+#include "IntakeQueue.hpp"
+#include "Journal.hpp"
+#include "PatientRegistry.hpp"
+#include "RecordSchema.hpp"
 
 // ------------------------------------------------------------
 // STRUCT: EmergencyCase — Represents one emergency patient record
 // ------------------------------------------------------------
 struct EmergencyCase {
-    int patientID;              // Unique ID (auto-generated)
+    int patientID;              // Unique case ID (auto-generated, ED ID space)
     std::string patientName;    // Patient name
     std::string emergencyType;  // Emergency category (Heart Attack, etc.)
     int priority;               // 1 = most critical, higher = less urgent
+    unsigned long arrivalSeq;   // Arrival order (FIFO tie-break among equal priorities)
+    long long arrivalTime = 0;  // Wall-clock arrival (seconds since epoch; 0 = stamp on insert)
+    long long triageKey = 0;    // Heap key: priority scaled by the aging policy + arrivalTime
+    int admissionID = 0;        // Role 1 patient ID the case came from; 0 = unknown (older files)
+
+    static constexpr int NOT_ADMITTED = -1;   // admissionID of a case logged in the ED
+};
+
+// Storage layout (emergency.txt rows, L journal records, emergency.bin):
+// ID,Name,Type,Priority[,ArrivalTime[,AdmissionID]] — arrival is optional (older files: stamped at
+// load), as is the admission ID (older files: 0, unknown). arrivalSeq and triageKey are rebuilt on load and never stored.
+typedef RecordSchema::Layout<EmergencyCase,
+                             RecordSchema::Field<&EmergencyCase::patientID>,
+                             RecordSchema::Field<&EmergencyCase::patientName>,
+                             RecordSchema::Field<&EmergencyCase::emergencyType>,
+                             RecordSchema::Field<&EmergencyCase::priority>,
+                             RecordSchema::Field<&EmergencyCase::arrivalTime, RecordSchema::OPTIONAL>,
+                             RecordSchema::Field<&EmergencyCase::admissionID, RecordSchema::OPTIONAL>>
+    EmergencyCaseLayout;
+
+// ------------------------------------------------------------
+// STRUCT: TriageEntry — one slot of the triage heap
+// ------------------------------------------------------------
+// What ordering needs, plus one reference to the patient's PatientRegistry record (name = patient
+// name, condition = emergency type). EmergencyCase stays the form of a case in files, journal
+// records and the API; the heap converts at its edges (load / push, pop / compaction).
+struct TriageEntry {
+    long long triageKey = 0;
+    long long arrivalTime = 0;
+    unsigned long arrivalSeq = 0;
+    int patientID = 0;
+    int priority = 0;
+    int admissionID = 0;
+    PatientRegistry::Handle patient = PatientRegistry::NONE;
+};
+
+// ------------------------------------------------------------
+// STRUCT: AgingPolicy — starvation avoidance for low-acuity cases
+// ------------------------------------------------------------
+// A case gains one priority level per secondsPerLevel of waiting. The heap key is
+//   priority * secondsPerLevel + arrivalTime
+// which orders cases exactly by effective priority (priority - waited / secondsPerLevel) at *every*
+// moment, so aging needs no re-sorting or periodic ticks: the heap stays O(log n) and the effective
+// priority is only computed for display when a case is popped. secondsPerLevel = 0 disables aging
+// (strict priority, then arrival). Loaded from data/triage_policy.txt ("seconds_per_level=600").
+struct AgingPolicy {
+    int secondsPerLevel = 600;
 };
 
 // ------------------------------------------------------------
@@ -45,30 +122,142 @@ struct EmergencyCase {
 // ------------------------------------------------------------
 class EmergencyDepartment {
 private:
-    static const int MAX_CASES = 100;     // Max array capacity
-    EmergencyCase cases[MAX_CASES];       // Array of cases
-    int size;                             // Current case count
+    PatientRegistry& registry;            // Shared patient records (PatientRegistry::shared())
+    ChunkedStore<TriageEntry> cases;      // Binary min-heap on (triageKey, arrivalSeq), growable
+    unsigned long nextSeq;                // Next arrival sequence number
+    std::unordered_map<int, int> heapPos; // patientID -> index in cases[]
+    std::unordered_set<int> retiredIds;   // Processed case IDs (tombstones): never re-imported
+    std::unordered_map<int, int> dispatchedTo; // Processed case ID -> ambulance sent (dispatch engine)
+    std::unordered_map<int, int> admittedAs;   // Processed case ID -> admission ID (absent: older build)
+    int nextID;                           // Next never-issued case ID (like PatientAdmission::nextId)
+    std::vector<int> freeIDs;             // Min-heap of unused IDs below nextID (gaps), lazily validated
+    Journal journal;                      // Append-only log (data/emergency.log)
+    Journal retiredLog;                   // Retired rows (data/emergency_retired.txt), appended on compaction
+    std::vector<int> retiredPending;      // Retired IDs whose row changed since it was last appended
+    std::vector<int> retiredInFlight;     // Rows the running compaction appends (re-queued if it fails)
+    bool compactionOk;                    // Set by the worker; read after join
+    std::thread compactor;                // Background compaction worker
+
+    // === Intake (see submitCase / drainIntake) ===
+    struct IntakeItem {
+        EmergencyCase c;
+        PatientRegistry::Handle patient = PatientRegistry::NONE; // Admissions: the record (c has no text)
+        std::chrono::steady_clock::time_point submittedAt;
+    };
+    IntakeQueue<IntakeItem> intake;
+    std::vector<long long> intakeWaits;   // Ring of recent submit -> heap waits (microseconds)
+    size_t intakeWaitNext;                // Next ring slot to overwrite
+
+    // === Aging + wait statistics ===
+    AgingPolicy aging;
+    std::vector<long long> servedWaits[11];   // Per priority 1-10: ring of recent waits (seconds)
+    size_t servedWaitNext[11];
+    void rekey(TriageEntry& e) const;         // triageKey from priority/arrivalTime (stamps arrival if 0)
+    void recordServed(const EmergencyCase& c, long long now);
+    void loadAgingPolicy();
+    static long long percentileOf(const std::vector<long long>& samples, double percentile);
+    int admissionToken;                   // EventBus::patientAdmitted() subscription
+
+    // === Search Indexes (maintained by heapify / pushCase / popCase / removeAt) ===
+    std::unordered_map<std::string, int> keyIds;           // Lowercased key -> interned handle
+    std::vector<std::string> keyText;                      // Handle -> lowercased key
+    std::unordered_map<int, std::unordered_set<int>> byNameKey; // Name handle -> patient IDs
+    std::unordered_map<int, std::unordered_set<int>> byTypeKey; // Type handle -> patient IDs
+    std::map<std::string, int, std::less<>> typeOrder;     // Lowercased type -> handle (prefix search)
+    std::unordered_map<int, std::pair<int, int>> caseKeys; // Patient ID -> (name handle, type handle)
+    std::string queryKey;                                  // Reused lowercasing buffer (no per-query alloc)
 
     // === Helper Functions ===
-    std::string toLowerCase(std::string str);                // Convert string to lowercase
+    static void lowerInto(std::string_view src, std::string& dst); // Lowercase into a reused buffer
+    int internKey(std::string_view text);                    // Handle for lowercased text (adds if new)
+    int findKey(std::string_view text);                      // Handle or -1, never allocates a key
+    void indexCase(const TriageEntry& e);                    // Add to name/type indexes
+    void unindexCase(int patientID);
+    std::vector<int> matchingCases(const std::unordered_map<int, std::unordered_set<int>>& index,
+                                   int key) const;           // Heap indices, triage order
     int getValidatedInput(int min, int max, std::string prompt); // Validate safe integer input
-    void sortCases();                                        // Sort by priority (ascending)
-    void saveCaseToFile(const EmergencyCase& newCase);       // Save one record to file
-    void loadPatientsFromFile();                             // Load new patients (from patients.txt)
+
+    // === Heap Helpers (all O(log n) unless noted) ===
+    static bool comesBefore(const TriageEntry& a, const TriageEntry& b); // Heap ordering
+    void swapCases(int i, int j);                            // Swap + keep heapPos in sync
+    void siftUp(int i);
+    void siftDown(int i);
+    void heapify();                                          // O(n) bottom-up build
+    TriageEntry entryFor(const EmergencyCase& c,             // Heap slot holding a registry reference:
+                         PatientRegistry::Handle record = PatientRegistry::NONE); // given (taken over) or shared
+    void copyOut(const TriageEntry& e, EmergencyCase& out) const; // Slot + registry text -> case
+    bool pushCase(TriageEntry e);                            // Insert (assigns arrivalSeq); takes e's reference
+    bool popCase(EmergencyCase& out);                        // Remove most critical (releases its record)
+    void changePriority(int index, int newPriority);         // Decrease/increase-key
+    void removeAt(int index);                                // Remove arbitrary case (replayed tombstone)
+    void saveCaseToFile(const EmergencyCase& newCase);       // Journal one new record (L)
+    static std::string caseRecord(const EmergencyCase& c);   // "L,id,name,type,priority"
+
+    // === Incremental Persistence ===
+    void logOperation(const std::string& entry);             // O(1) append, compaction when due
+    void applyJournalEntry(std::string_view entry);        // Idempotent replay of L / U / X / D
+    void loadRetiredIds();                                   // Tombstones from last compaction
+    void startCompaction();                                  // Copy state, rotate log, write in background
+    void waitForCompaction();                                // Join the background worker (re-queues failed rows)
     void loadExistingEmergencies();                          // Load existing emergency cases (from emergency.txt)
-    int generateNextID();                                    // Generate next unique ID
+    bool isLegacyImport(const EmergencyCase& row) const;     // Resync: row already pending from an older import
+    bool loadBinarySnapshot();                               // Fast path: emergency.bin (if current)
+    int generateNextID();                                    // Generate next unique ID (O(1) amortised)
+    void seedIDAllocator();                                  // One-time scan of known IDs at startup
+    void releaseID(int id);                                  // Return an unused ID (aborted entry)
 
 public:
     EmergencyDepartment();       // Constructor — auto-loads data
-    ~EmergencyDepartment() {}    // Destructor (no dynamic memory)
+    ~EmergencyDepartment();      // Destructor — final compaction
 
     // === Core Functionalities ===
     void logEmergencyCase();     // Add new emergency record
     void processCriticalCase();  // Handle & remove most urgent case
-    void viewPendingCases();     // Display all pending emergencies
+    void viewPendingCases();     // Display pending emergencies, one page at a time
     void searchByPatientName();  // Search by patient name (case-insensitive)
     void searchByEmergencyType();// Search by type (e.g., “Heart Attack”)
+    void searchByTypePrefix();   // Search by type prefix (e.g., “card” → “Cardiac Arrest”)
     void updatePriority();       // Update existing patient priority
+    void loadPatientsFromFile(); // Resync: import admitted patients missing from triage (patients.txt)
+
+    // === Headless API (batch mode: no prompts) ===
+    int logCase(const std::string& name, const std::string& type, int priority); // ID or -1 (priority 0 = by type)
+    bool setPriority(int patientID, int newPriority);                           // False if not pending
+    int pendingCount() const { return static_cast<int>(cases.size()) + intake.depth(); } // Incl. queued intake
+    static int standardPriority(const std::string& type); // Built-in types 1-4, else 0
+
+    // Lazy walk of the pending cases in triage order, without sorting the heap: a small frontier
+    // heap of heap indices starts at the root and each visited case adds its two children, so the
+    // top k cost O(k log k) whatever the queue length. Valid until the heap next changes.
+    class TriageCursor {
+    public:
+        explicit TriageCursor(const EmergencyDepartment& ed);
+        const TriageEntry* next();              // nullptr once every pending case was visited
+        int index() const { return current; }   // Heap index of the case next() returned last
+    private:
+        const EmergencyDepartment& ed;
+        std::vector<int> frontier;
+        int current;
+    };
+    bool viewPendingCases(int offset, int limit) const; // Ranks offset+1 .. offset+limit; true if more follow
+
+    // === Dispatch link (see DispatchEngine) ===
+    bool takeNextCase(EmergencyCase& out);   // Pop + tombstone the most critical case, no output
+    bool recordDispatch(int patientID, int ambulanceId); // Processed cases only; journaled (D)
+    int dispatchedUnit(int patientID) const; // Ambulance sent to a processed case, 0 if none
+
+    // === Intake queue (producers: any thread, lock-free; consumer: whoever owns the heap) ===
+    bool submitCase(EmergencyCase c);        // patientID 0 = assign on drain (a taken ID is reported and dropped); false if priority invalid
+    int drainIntake();                       // Queued cases -> heap (one journal write). Returns count
+    int intakeDepth() const { return intake.depth(); }
+    long long intakeWaitUs(double percentile) const; // Submit -> heap wait over recent drains (0 if none)
+
+    // === Aging policy + wait-time report ===
+    const AgingPolicy& agingPolicy() const { return aging; }
+    bool setAgingPolicy(const AgingPolicy& policy);  // Re-keys + heapifies (O(n)); saved to triage_policy.txt
+    int effectivePriority(const EmergencyCase& c, long long now) const; // Aged priority (>= 1)
+    long long waitPercentile(int priority, double percentile) const;   // Seconds, over served cases
+    void viewWaitTimes() const;  // Per-priority wait percentiles of processed cases
 
     // === UI/Integration ===
     void displayMenu();          // Sub-menu for Emergency Department
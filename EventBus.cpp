@@ -0,0 +1,13 @@
+// EventBus.cpp
+// Process-wide channel instances (see EventBus.hpp).
+
+#include "EventBus.hpp"
+
+namespace EventBus {
+
+EventChannel<PatientAdmitted>& patientAdmitted() {
+    static EventChannel<PatientAdmitted> channel;   // Constructed on first use (thread-safe)
+    return channel;
+}
+
+} // namespace EventBus
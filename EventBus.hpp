@@ -0,0 +1,73 @@
+// EventBus.hpp
+// In-process publish/subscribe channels between the roles.
+// Data Structure Choice: PER-EVENT-TYPE CHANNEL (token-keyed listener list)
+// Why?
+// - Role 1 and Role 3 used to be linked only through data/patients.txt: the Emergency Department
+//   re-read and de-duplicated the whole file at startup, so a new admission reached triage only
+//   after a restart. Now PatientAdmission publishes each admission as it happens and the Emergency
+//   Department subscribes — O(1) per patient, no rescan.
+// - Publishers do not know who listens (no Role 1 -> Role 3 include); subscribers unsubscribe with
+//   the token they were given, like DutyClock's listeners.
+// - Threads: publish() may run on several service threads at once (listeners are called under a
+//   shared lock and must be thread-safe themselves); subscribe/unsubscribe take it exclusively.
+
+#ifndef EVENT_BUS_HPP
+#define EVENT_BUS_HPP
+
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "PatientRegistry.hpp"
+
+template <typename Event>
+class EventChannel {
+public:
+    using Listener = std::function<void(const Event&)>;
+
+    EventChannel() : nextToken_(1) {}
+
+    int subscribe(Listener listener) {   // Returns a token for unsubscribe()
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        int token = nextToken_++;
+        listeners_.push_back(std::make_pair(token, std::move(listener)));
+        return token;
+    }
+
+    void unsubscribe(int token) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (size_t i = 0; i < listeners_.size(); ++i) {
+            if (listeners_[i].first == token) {
+                listeners_.erase(listeners_.begin() + i);
+                return;
+            }
+        }
+    }
+
+    void publish(const Event& event) const {   // Listeners run on the publisher's thread, in order
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& l : listeners_) l.second(event);
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::vector<std::pair<int, Listener>> listeners_;
+    int nextToken_;
+};
+
+namespace EventBus {
+
+// A patient joined the admission queue (published by PatientAdmission::admit / admitBatch).
+// The record lives in PatientRegistry::shared(); a listener that keeps it calls retain(patient).
+struct PatientAdmitted {
+    int id;
+    PatientRegistry::Handle patient;   // Name (uppercased) and condition, as queued
+};
+
+EventChannel<PatientAdmitted>& patientAdmitted();   // Process-wide channel
+
+} // namespace EventBus
+
+#endif // EVENT_BUS_HPP
@@ -0,0 +1,69 @@
+// IntakeQueue.hpp
+// Lock-free multi-producer / single-consumer queue for Role 3's case intake.
+// Data Structure Choice: LINKED MPSC QUEUE (Vyukov style: one atomic exchange per push)
+// Why?
+// - Ambulance crews, admission desks and device feeds push from their own threads. A push is one
+//   allocation, one atomic exchange of the head and one store: no lock, no CAS retry loop, and it
+//   never waits for the triage heap (sifting, journaling) — the producer's latency stays flat
+//   however large the heap or the surge.
+// - Exactly one consumer (the triage drain) pops in FIFO order and batches the cases into the heap.
+// - A producer that has swapped the head but not yet linked its node makes the queue look empty
+//   at that point; pop() then simply stops early and the item is picked up by the next drain.
+// Contract: push() from any thread; pop() only from one thread at a time (the owner's drain).
+
+#ifndef INTAKE_QUEUE_HPP
+#define INTAKE_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+template <typename T>
+class IntakeQueue {
+public:
+    IntakeQueue() : head_(new Node()), tail_(head_.load()), depth_(0) {}
+    ~IntakeQueue() {
+        T discard;
+        while (pop(discard)) {}
+        delete tail_;
+    }
+
+    IntakeQueue(const IntakeQueue&) = delete;
+    IntakeQueue& operator=(const IntakeQueue&) = delete;
+
+    // Any thread. Wait-free apart from the node allocation.
+    void push(T value) {
+        Node* n = new Node(std::move(value));
+        depth_.fetch_add(1, std::memory_order_relaxed);   // Before publishing: pop never sees it first
+        Node* prev = head_.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    // Consumer only. False when empty (or the newest push is not linked yet).
+    bool pop(T& out) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        out = std::move(next->value);
+        tail_ = next;   // next becomes the new sentinel
+        delete tail;
+        depth_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Approximate number of queued items (exact when no push is in flight).
+    int depth() const { return depth_.load(std::memory_order_relaxed); }
+
+private:
+    struct Node {
+        Node() : next(nullptr) {}
+        explicit Node(T v) : value(std::move(v)), next(nullptr) {}
+        T value;
+        std::atomic<Node*> next;
+    };
+
+    std::atomic<Node*> head_;   // Newest node (producers swap it)
+    Node* tail_;                // Sentinel before the oldest item (consumer only)
+    std::atomic<int> depth_;
+};
+
+#endif // INTAKE_QUEUE_HPP
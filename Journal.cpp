@@ -0,0 +1,184 @@
+// Journal.cpp
+// Implementation of the shared append-only journal (see Journal.hpp for the design).
+// Complexity Summary:
+//   append   → O(1) write + flush, fsync every SYNC_EVERY entries
+//   appendBatch → one write + flush for k entries; fsync now (FORCE_SYNC) or at SYNC_EVERY (BATCHED)
+//   replay   → O(j) over journal entries (startup only, memory-mapped)
+//   truncate → O(1)
+
+#include "Journal.hpp"
+#include "CsvTokenizer.hpp"
+#include "MappedFile.hpp"
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#define JOURNAL_FSYNC(f) _commit(_fileno(f))
+#else
+#include <unistd.h>
+#define JOURNAL_FSYNC(f) fsync(fileno(f))
+#endif
+
+using namespace std;
+
+Journal::Journal(const string& path) : path_(path), file_(nullptr), entries_(0), unsynced_(0) {
+    reopen("ab");
+}
+
+Journal::~Journal() {
+    sync();
+    if (file_) fclose(file_);
+}
+
+void Journal::reopen(const char* mode) {
+    if (file_) fclose(file_);
+    file_ = fopen(path_.c_str(), mode);
+}
+
+bool Journal::append(const string& entry) {
+    if (!file_) return false;
+    if (fwrite(entry.data(), 1, entry.size(), file_) != entry.size()) return false;
+    if (fputc('\n', file_) == EOF) return false;
+    fflush(file_);                 // Hand to the OS now: survives a process crash.
+    entries_++;
+    if (++unsynced_ >= SYNC_EVERY) sync();
+    return true;
+}
+
+bool Journal::appendBatch(const vector<string>& entries, Durability durability) {
+    if (!file_) return false;
+    if (entries.empty()) return true;
+    size_t total = 0;
+    for (const string& e : entries) total += e.size() + 1;
+    string block;
+    block.reserve(total);
+    for (const string& e : entries) {
+        block += e;
+        block += '\n';
+    }
+    if (fwrite(block.data(), 1, block.size(), file_) != block.size()) return false;
+    entries_ += static_cast<int>(entries.size());
+    unsynced_ += static_cast<int>(entries.size());
+    if (durability == FORCE_SYNC || unsynced_ >= SYNC_EVERY) {
+        sync();                    // One flush + fsync for the whole batch.
+    } else {
+        fflush(file_);             // As append: with the OS now, fsync at the next SYNC_EVERY.
+    }
+    return true;
+}
+
+void Journal::sync() {
+    if (!file_ || unsynced_ == 0) return;
+    fflush(file_);
+    JOURNAL_FSYNC(file_);          // Batched: one disk flush per SYNC_EVERY entries.
+    unsynced_ = 0;
+}
+
+int Journal::replay(const function<void(string_view)>& fn) {
+    long goodBytes = 0;
+    bool torn = false;
+    int count = scan(path_, fn, goodBytes, torn);
+
+    // A torn write without '\n' at the end: cut it off so the next append does not glue
+    // onto half an entry.
+    if (torn) {
+        if (file_) fclose(file_);
+        error_code ec;
+        filesystem::resize_file(path_, static_cast<uintmax_t>(goodBytes), ec);
+        file_ = fopen(path_.c_str(), "ab");
+    }
+    entries_ = count;
+    return count;
+}
+
+int Journal::replayFile(const string& path, const function<void(string_view)>& fn) {
+    long goodBytes = 0;
+    bool torn = false;
+    return scan(path, fn, goodBytes, torn);
+}
+
+int Journal::scan(const string& path, const function<void(string_view)>& fn,
+                  long& goodBytes, bool& torn) {
+    goodBytes = 0;
+    torn = false;
+    MappedFile file;
+    if (!file.open(path)) return 0;
+
+    string_view data = file.view();
+    size_t lastNl = data.rfind('\n');
+    size_t complete = lastNl == string_view::npos ? 0 : lastNl + 1;
+    goodBytes = static_cast<long>(complete);
+    torn = complete < data.size();   // Leftover bytes = torn final entry, never replayed.
+
+    int count = 0;
+    CsvLineReader lines(data.substr(0, complete));
+    string_view line;
+    while (lines.nextLine(line)) {
+        if (line.empty()) continue;
+        fn(line);
+        count++;
+    }
+    return count;
+}
+
+bool Journal::truncate() {
+    reopen("wb");                  // Truncate to zero length...
+    reopen("ab");                  // ...then continue appending.
+    entries_ = 0;
+    unsynced_ = 0;
+    return file_ != nullptr;
+}
+
+// An archive that is still on disk holds entries no snapshot contains yet (its compaction failed, or
+// the process died while it ran): renaming over it would drop them, so the live entries are
+// appended to it instead and the next successful compaction folds in both.
+bool Journal::rotate(const string& archivePath) {
+    sync();
+    if (file_) fclose(file_);
+    file_ = nullptr;
+    error_code ec;
+    bool moved;
+    if (filesystem::exists(archivePath, ec)) {
+        moved = appendEntries(path_, archivePath);
+        if (moved) reopen("wb");   // Now in the archive: start the live journal empty
+    } else {
+        filesystem::rename(path_, archivePath, ec);
+        moved = !ec;
+    }
+    reopen("ab");
+    entries_ = 0;
+    unsynced_ = 0;
+    return moved && file_ != nullptr;
+}
+
+// Complete entries of fromPath appended to toPath (whose torn tail, if any, is cut first), synced.
+bool Journal::appendEntries(const string& fromPath, const string& toPath) {
+    long keep = 0;
+    bool torn = false;
+    scan(toPath, [](string_view) {}, keep, torn);
+    if (torn) {
+        error_code ec;
+        filesystem::resize_file(toPath, static_cast<uintmax_t>(keep), ec);
+        if (ec) return false;
+    }
+
+    MappedFile from;
+    string_view data;
+    if (from.open(fromPath)) {
+        data = from.view();
+        size_t lastNl = data.rfind('\n');
+        data = data.substr(0, lastNl == string_view::npos ? 0 : lastNl + 1);
+    }
+    FILE* out = fopen(toPath.c_str(), "ab");
+    if (!out) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), out) == data.size() && fflush(out) == 0;
+    JOURNAL_FSYNC(out);
+    return fclose(out) == 0 && ok;
+}
+
+bool Journal::replaceFile(const string& tmpPath, const string& finalPath) {
+    error_code ec;
+    filesystem::rename(tmpPath, finalPath, ec);  // Atomic replace on POSIX; replaces on Windows too.
+    return !ec;
+}
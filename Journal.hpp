@@ -0,0 +1,85 @@
+// Journal.hpp
+// Shared write-ahead append log used by every module for O(1) persistence.
+// Design: SNAPSHOT (CSV) + APPEND-ONLY JOURNAL
+// - Each mutation appends one short line ("OP,fields...") instead of rewriting the whole CSV.
+//   The line is flushed to the OS immediately (survives a process crash); fsync is batched
+//   every SYNC_EVERY entries or on sync(), so durability costs O(1) amortised per operation.
+// - Startup = load snapshot, then replay the journal on top of it.
+// - Compaction folds the journal back into the snapshot (module rewrites its CSV) and truncates.
+// - Entries are written by the modules as idempotent, ID-keyed state records, so replaying a
+//   journal over a snapshot that already contains some of its effects is harmless. This makes a
+//   crash between "snapshot written" and "journal truncated" safe.
+// - Torn tails: a final line without '\n' (crash mid-write) is ignored on replay.
+// - Replay reads the journal through MappedFile and hands out string_view entries (no per-line copy).
+
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Journal {
+public:
+    static const int SYNC_EVERY = 32;      // fsync batch size
+    static const int COMPACT_EVERY = 256;  // Suggested compaction threshold for modules
+
+    // appendBatch durability: BATCHED counts the entries toward the SYNC_EVERY fsync like append
+    // (routine operations that write several entries); FORCE_SYNC fsyncs the batch before returning.
+    enum Durability { BATCHED, FORCE_SYNC };
+
+    explicit Journal(const std::string& path);
+    ~Journal();                            // Flushes + syncs pending entries
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    bool isOpen() const { return file_ != nullptr; }
+    const std::string& path() const { return path_; }
+
+    // Append one entry (no trailing newline needed). O(1) I/O.
+    bool append(const std::string& entry);
+
+    // Append many entries as one buffered write + one flush; fsync per Durability (FORCE_SYNC for
+    // bulk imports).
+    bool appendBatch(const std::vector<std::string>& entries, Durability durability = FORCE_SYNC);
+
+    // Flush and fsync everything appended so far.
+    void sync();
+
+    // Feed every complete entry to fn, in order. Returns number of entries replayed.
+    int replay(const std::function<void(std::string_view)>& fn);
+
+    // Entries appended/replayed since the last truncate (drives compaction).
+    int entries() const { return entries_; }
+    bool needsCompaction() const { return entries_ >= COMPACT_EVERY; }
+
+    // Discard all entries (call only after the snapshot has been rewritten).
+    bool truncate();
+
+    // Background compaction support: move the current journal to archivePath and start a fresh,
+    // empty one. New entries keep flowing while the archived entries are folded into the snapshot.
+    // An archive left by an earlier, unfinished compaction is kept: the entries are appended to it.
+    bool rotate(const std::string& archivePath);
+
+    // Replay an arbitrary journal file (e.g. an archive left by an interrupted compaction).
+    static int replayFile(const std::string& path, const std::function<void(std::string_view)>& fn);
+
+    // Crash-safe snapshot replacement: write to tmpPath, then rename over finalPath.
+    static bool replaceFile(const std::string& tmpPath, const std::string& finalPath);
+
+private:
+    std::string path_;
+    FILE* file_;
+    int entries_;    // Entries in the journal file
+    int unsynced_;   // Entries since last fsync
+
+    void reopen(const char* mode);
+    static bool appendEntries(const std::string& fromPath, const std::string& toPath);
+    static int scan(const std::string& path, const std::function<void(std::string_view)>& fn,
+                    long& goodBytes, bool& torn);
+};
+
+#endif // JOURNAL_HPP
@@ -0,0 +1,39 @@
+// Log.cpp
+// Implementation of the shared output layer (see Log.hpp).
+
+#include "Log.hpp"
+#include <iostream>
+
+using namespace std;
+
+namespace {
+
+Log::Level activeLevel = Log::VERBOSE;
+bool ticketsOn = true;
+thread_local ostream nullStream(nullptr);   // No buffer: insertions are no-ops (per thread: they still set state)
+thread_local ostream* boundSink = nullptr;
+
+ostream& sink() { return boundSink ? *boundSink : cout; }
+
+} // namespace
+
+namespace Log {
+
+void init() {
+    ios::sync_with_stdio(false);   // cout gets its own buffer instead of per-call stdio writes
+}
+
+void setLevel(Level level) { activeLevel = level; }
+Level level() { return activeLevel; }
+void setTickets(bool on) { ticketsOn = on; }
+bool tickets() { return ticketsOn; }
+
+void bind(ostream* sink) { boundSink = sink; }
+
+ostream& error() { return sink(); }
+ostream& result() { return activeLevel >= NORMAL ? sink() : nullStream; }
+ostream& status() { return activeLevel >= VERBOSE ? sink() : nullStream; }
+
+void flush() { sink().flush(); }
+
+} // namespace Log
@@ -0,0 +1,46 @@
+// Log.hpp
+// Shared console output layer for the four roles and batch mode.
+// Why a layer instead of raw cout << ... << endl?
+// - Load/save status lines, per-operation results and the admission ticket were written with endl:
+//   one flush (write syscall) per line. Under batch load the console cost more than the data work.
+// - Messages now carry a level: Log::status() (persistence chatter: loaded / saved / replayed),
+//   Log::result() (outcome of an operation) and Log::error(). Anything below the active verbosity
+//   goes to a null stream: no I/O, the insertions fail fast on the stream's bad state.
+// - The sink is cout with its own buffer (Log::init() unsyncs it from stdio) and these paths never
+//   use endl, so output reaches the terminal when the buffer fills, before cin reads (cin stays
+//   tied to cout, so prompts still appear in time) or at exit / Log::flush().
+// - Ticket rendering can be switched off on its own (Log::setTickets(false)).
+// - A thread can bind its own sink (Log::bind): service-mode workers capture each request's output
+//   in a per-terminal buffer instead of interleaving on the shared cout.
+// Menus and prompts still write to cout directly: they only run interactively. The paged table views
+// write to result(), so batch and service commands can show a page too.
+
+#ifndef LOG_HPP
+#define LOG_HPP
+
+#include <ostream>
+
+namespace Log {
+
+enum Level {
+    QUIET = 0,     // Errors only
+    NORMAL = 1,    // + operation results
+    VERBOSE = 2    // + load/save status (default)
+};
+
+void init();                 // Buffered cout; call once at startup, before any output
+void setLevel(Level level);
+Level level();
+void setTickets(bool on);    // Admission tickets (default on)
+bool tickets();
+
+void bind(std::ostream* sink);   // This thread's sink (nullptr = cout). Level/tickets stay global.
+
+std::ostream& error();       // Always shown
+std::ostream& result();      // NORMAL and above
+std::ostream& status();      // VERBOSE only
+void flush();
+
+} // namespace Log
+
+#endif // LOG_HPP
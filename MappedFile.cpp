@@ -0,0 +1,109 @@
+// MappedFile.cpp
+// Implementation of the memory-mapped bulk reader (see MappedFile.hpp).
+// Complexity: open → O(1) syscalls when mapped (pages load lazily); O(n) single read on fallback.
+
+#include "MappedFile.hpp"
+#include "CsvTokenizer.hpp"   // readFileToBuffer() fallback
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), open_(false), mapped_(nullptr)
+#ifdef _WIN32
+    , fileHandle_(nullptr), mapHandle_(nullptr)
+#endif
+{}
+
+MappedFile::MappedFile(const string& path) : MappedFile() {
+    open(path);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const string& path) {
+    close();
+
+#if defined(MAPPED_FILE_POSIX)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    bool haveStat = fstat(fd, &st) == 0;
+    if (haveStat && !S_ISREG(st.st_mode)) {   // E.g. a directory in the file's place: nothing to read
+        ::close(fd);
+        return false;
+    }
+    if (haveStat && st.st_size > 0) {
+        void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);   // Read-ahead hint
+            mapped_ = p;
+            data_ = static_cast<const char*>(p);
+            size_ = static_cast<size_t>(st.st_size);
+        }
+    }
+    ::close(fd);   // The mapping stays valid after the descriptor is closed.
+    if (mapped_) {
+        open_ = true;
+        return true;
+    }
+#elif defined(_WIN32)
+    HANDLE fh = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fh == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER len;
+    if (GetFileSizeEx(fh, &len) && len.QuadPart > 0) {
+        HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mh) {
+            void* p = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+            if (p) {
+                fileHandle_ = fh;
+                mapHandle_ = mh;
+                mapped_ = p;
+                data_ = static_cast<const char*>(p);
+                size_ = static_cast<size_t>(len.QuadPart);
+                open_ = true;
+                return true;
+            }
+            CloseHandle(mh);
+        }
+    }
+    CloseHandle(fh);
+#endif
+
+    // Portable fallback (also used for empty files, which cannot be mapped).
+    if (!readFileToBuffer(path, fallback_)) return false;
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_) {
+#if defined(MAPPED_FILE_POSIX)
+        munmap(mapped_, size_);
+#elif defined(_WIN32)
+        UnmapViewOfFile(mapped_);
+        CloseHandle(static_cast<HANDLE>(mapHandle_));
+        CloseHandle(static_cast<HANDLE>(fileHandle_));
+        mapHandle_ = fileHandle_ = nullptr;
+#endif
+    }
+    mapped_ = nullptr;
+    fallback_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
@@ -0,0 +1,50 @@
+// MappedFile.hpp
+// Read-only whole-file view for the bulk loaders (snapshots + journal replay).
+// Why memory-map?
+// - A cold start over multi-megabyte archives becomes one sequential page-cache read:
+//   no per-line getline calls, no copy into a user buffer, pages faulted in on demand
+//   (with a sequential read-ahead hint).
+// - The loaders tokenize straight out of the mapping via CsvTokenizer's string_view fields.
+// Portability:
+// - POSIX: mmap(PROT_READ, MAP_PRIVATE) + madvise(MADV_SEQUENTIAL).
+// - Windows: CreateFileMapping / MapViewOfFile.
+// - Anything else, or if mapping fails (e.g. empty file, special filesystem): falls back to a
+//   single bulk read into an owned buffer. Callers see the same std::string_view either way.
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <string_view>
+
+class MappedFile {
+public:
+    MappedFile();
+    explicit MappedFile(const std::string& path);   // Convenience: open() immediately
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map (or read) the whole file. False if the file cannot be opened.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return open_; }
+    bool isMapped() const { return mapped_ != nullptr; }   // false = fallback buffer in use
+    std::string_view view() const { return std::string_view(data_, size_); }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    bool open_;
+    void* mapped_;          // Base of the mapping (nullptr when using the fallback)
+    std::string fallback_;  // Owned copy when mapping is unavailable
+#ifdef _WIN32
+    void* fileHandle_;
+    void* mapHandle_;
+#endif
+};
+
+#endif // MAPPED_FILE_HPP
@@ -19,24 +19,38 @@
 //   resource tracking, ensuring accountability and preventing overuse.
 // ----------------------------------------------------------------------------
 // Complexity Summary:
-//   Push (Add Supply)        → O(1)
-//   Pop (Use Last Supply)    → O(1)
+//   Push (Add Supply)        → O(log n)  (list O(1) + secondary indexes)
+//   Pop (Use Last Supply)    → O(log n)
 //   View (Traverse Stack)    → O(n)
+//   Expiring within N days   → O(log n + k)
+//   Total by name            → O(1)
+//   FEFO use by name         → O(b log n), b = batches touched
 //   File I/O (Save/Load)     → O(n)
+//   Journal append per op    → O(1)
 // ============================================================================
 
 #include "MedicalSupply.hpp"
+#include "BinarySnapshot.hpp"
+#include "CsvTokenizer.hpp"
+#include "MappedFile.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "PagedView.hpp"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <limits>
 #include <string>
 #include <cctype>
+#include <ctime>
+#include <algorithm>
 
 using namespace std;
 
 static const char* PRIMARY_PATH   = "data/medical_supplies.txt";
 static const char* FALLBACK_PATH  = "medicalSupply.txt";
+static const char* JOURNAL_PATH   = "data/medical_supplies.log";
+static const char* BINARY_PATH    = "data/medical_supplies.bin";
 
 void MedicalSupply::trim(std::string& s) {
     size_t i = 0;
@@ -51,33 +65,6 @@ void MedicalSupply::trim(std::string& s) {
     s.erase(j + 1);
 }
 
-bool MedicalSupply::parseCsvLine(const std::string& line, Supply& s) {
-    size_t p1 = line.find(',');
-    if (p1 == string::npos) return false;
-    size_t p2 = line.find(',', p1 + 1);
-    if (p2 == string::npos) return false;
-    size_t p3 = line.find(',', p2 + 1);
-    if (p3 == string::npos) return false;
-    size_t p4 = line.find(',', p3 + 1);
-    if (p4 == string::npos) return false;
-    size_t p5 = line.find(',', p4 + 1);
-    if (p5 == string::npos) return false;
-
-    try {
-        s.id       = stoi(line.substr(0, p1));
-        s.name     = line.substr(p1 + 1, p2 - p1 - 1);
-        s.quantity = stoi(line.substr(p2 + 1, p3 - p2 - 1));
-        s.batch    = line.substr(p3 + 1, p4 - p3 - 1);
-        s.expiry   = line.substr(p4 + 1, p5 - p4 - 1);
-        s.notes    = line.substr(p5 + 1);
-    } catch (...) {
-        return false;
-    }
-
-    trim(s.name); trim(s.batch); trim(s.expiry); trim(s.notes);
-    return true;
-}
-
 bool MedicalSupply::isAlnumDash(const std::string& s) {
     if (s.empty()) return false;
     for (unsigned char c : s)
@@ -96,42 +83,176 @@ bool MedicalSupply::isValidDate(const std::string& d) {
     return true;
 }
 
-MedicalSupply::MedicalSupply() : top_(nullptr), nextId_(1) {
+int MedicalSupply::expiryDay(const std::string& d) {
+    // Packed day number (days since 1970-01-01, proleptic Gregorian): integer compares
+    // instead of string compares, and "within N days" is plain subtraction.
+    if (!isValidDate(d)) return NO_EXPIRY;
+    int y = stoi(d.substr(0, 4)), m = stoi(d.substr(5, 2)), day = stoi(d.substr(8, 2));
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+int MedicalSupply::today() {
+    time_t now = time(nullptr);
+    struct tm t;
+#ifdef _WIN32
+    localtime_s(&t, &now);
+#else
+    localtime_r(&now, &t);   // Reentrant: modules may run on different service threads
+#endif
+    char buf[11];
+    strftime(buf, sizeof(buf), "%Y-%m-%d", &t);
+    return expiryDay(buf);
+}
+
+std::string MedicalSupply::nameKey(const std::string& name) {
+    string key = name;
+    trim(key);
+    for (char& c : key) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return key;
+}
+
+MedicalSupply::MedicalSupply() : top_(nullptr), nextId_(1), journal_(JOURNAL_PATH) {
     if (!loadFromFile()) {
-        cout << "[MedicalSupply] No database found. Starting with an empty stack.\n";
+        Log::status() << "[MedicalSupply] No database found. Starting with an empty stack.\n";
+    }
+    // Replay operations logged since the last compaction, then fold them in.
+    if (journal_.replay([this](string_view e) { applyJournalEntry(e); }) > 0) {
+        compact();
     }
 }
 MedicalSupply::~MedicalSupply() {
+    if (journal_.entries() > 0) compact();
     clearAll();
 }
 
+// ---- Journal persistence ----
+// Entry formats:  P,<ID,Name,Quantity,Batch,Expiry,Notes>   (push)
+//                 U,<id>,<quantity>                        (quantity set in place)
+//                 O,<id>                                   (node removed)
+void MedicalSupply::logOperation(const std::string& entry) {
+    if (!journal_.append(entry)) {  // No journal available: old full-rewrite behaviour.
+        saveToFile();
+        return;
+    }
+    if (journal_.needsCompaction()) compact();
+}
+
+void MedicalSupply::logOperations(const std::vector<std::string>& entries) {
+    if (!journal_.appendBatch(entries, Journal::BATCHED)) {   // Same fsync batching as logOperation
+        saveToFile();
+        return;
+    }
+    if (journal_.needsCompaction()) compact();
+}
+
+MedicalSupply::Node* MedicalSupply::findById(int id) const {
+    auto it = byId_.find(id);
+    return it == byId_.end() ? nullptr : it->second;
+}
+
+void MedicalSupply::applyJournalEntry(std::string_view entry) {
+    if (entry.size() < 2 || entry[1] != ',') return;
+    string_view body = string_view(entry).substr(2);
+    if (entry[0] == 'P') {
+        Supply s{};
+        if (SupplyLayout::parseCsv(body, s) && s.id >= nextId_) pushNode(s);  // Lower IDs: already in snapshot.
+        return;
+    }
+
+    CsvTokenizer tok(body);
+    string_view idField, qtyField;
+    int id;
+    if (!tok.next(idField) || !parseIntField(idField, id)) return;
+    Node* n = findById(id);
+    if (!n) return;  // Already removed in the snapshot.
+
+    if (entry[0] == 'U') {
+        int qty;
+        if (tok.next(qtyField) && parseIntField(qtyField, qty)) setQuantity(n, qty);
+    } else if (entry[0] == 'O') {
+        removeNode(n);
+    }
+}
+
+void MedicalSupply::compact() {
+    if (saveToFile()) {
+        saveToBinary(BINARY_PATH);  // After the TXT, so the .bin is the newer file
+        journal_.truncate();
+    }
+}
+
 void MedicalSupply::clearAll() {
+    // Run the node destructors (string payloads), then hand every slot back to the pool at once.
     while (top_) {
         Node* t = top_;
         top_ = top_->next;
-        delete t;
+        t->~Node();
     }
+    pool_.reset();
+    byId_.clear();
+    byExpiry_.clear();
+    byName_.clear();
 }
 void MedicalSupply::pushNode(const Supply& s) {
-    Node* n = new Node(s);
+    Node* n = pool_.create(s);
     n->next = top_;
+    if (top_) top_->prev = n;
     top_ = n;
+    indexNode(n);
+}
+MedicalSupply::Node* MedicalSupply::appendBottom(const Supply& s, Node* bottom) {
+    // Loader path: file order is top -> bottom, so each row goes under the previous one.
+    Node* n = pool_.create(s);
+    n->prev = bottom;
+    if (bottom) bottom->next = n; else top_ = n;
+    indexNode(n);
+    return n;
+}
+void MedicalSupply::indexNode(Node* n) {
+    const Supply& s = n->data;
     if (s.id >= nextId_) nextId_ = s.id + 1;
+
+    int day = expiryDay(s.expiry);
+    byId_[s.id] = n;
+    n->expiryPos = byExpiry_.emplace(day, n);
+    NameIndex& idx = byName_[nameKey(s.name)];
+    idx.total += s.quantity;
+    n->batchPos = idx.batches.emplace(day, n);
+    Metrics::setGauge(Metrics::SUPPLY_STACK, static_cast<long long>(byId_.size()));
 }
 bool MedicalSupply::popNode(Supply& out) {
     if (!top_) return false;
-    Node* n = top_;
-    out = n->data;
-    top_ = n->next;
-    delete n;
+    out = top_->data;
+    removeNode(top_);
     return true;
 }
+void MedicalSupply::removeNode(Node* n) {
+    byId_.erase(n->data.id);
+    byExpiry_.erase(n->expiryPos);
+    auto it = byName_.find(nameKey(n->data.name));
+    it->second.total -= n->data.quantity;
+    it->second.batches.erase(n->batchPos);
+    if (it->second.batches.empty()) byName_.erase(it);
+
+    if (n->prev) n->prev->next = n->next; else top_ = n->next;
+    if (n->next) n->next->prev = n->prev;
+    pool_.destroy(n);
+    Metrics::setGauge(Metrics::SUPPLY_STACK, static_cast<long long>(byId_.size()));
+}
+void MedicalSupply::setQuantity(Node* n, int quantity) {
+    byName_[nameKey(n->data.name)].total += quantity - n->data.quantity;
+    n->data.quantity = quantity;
+}
 
 bool MedicalSupply::addSupply() {
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
     Supply s;
-    s.id = nextId_;
 
     cout << "Enter supply name: ";
     getline(cin, s.name);
@@ -152,18 +273,27 @@ bool MedicalSupply::addSupply() {
     cout << "Notes/Remarks: ";
     getline(cin, s.notes);
 
+    return addSupply(s);
+}
+
+bool MedicalSupply::addSupply(Supply s) {
+    Metrics::Timer timer(Metrics::ADD_SUPPLY);
+    // Non-interactive core (also used by batch mode): s.id is assigned here.
+    s.id = nextId_;
     trim(s.name); trim(s.batch); trim(s.expiry); trim(s.notes);
     if (s.name.empty() || s.quantity <= 0) {
-        cout << "Invalid input. Supply not added.\n";
+        Log::error() << "Invalid input. Supply not added.\n";
         return false;
     }
 
     pushNode(s);
 
-    cout << "Added supply ID " << s.id << ": " << s.name
+    Log::result() << "Added supply ID " << s.id << ": " << s.name
          << " (" << s.quantity << " units)\n";
 
-    saveToFile();
+    string entry = "P,";
+    SupplyLayout::appendCsv(entry, s);
+    logOperation(entry);
     return true;
 }
 
@@ -197,19 +327,13 @@ bool MedicalSupply::useLastAddedSupply() {
         return false;
     }
 
-    peek.quantity -= useQty;
-
-    if (peek.quantity == 0) {
-        cout << "✅ All units used. Removing supply from stack...\n";
-        Supply used{};
-        popNode(used);
-    } else {
-        cout << "✅ " << useQty << " units used from " << peek.name
-             << " (Remaining: " << peek.quantity << ")\n";
-    }
+    return useLast(useQty);
+}
 
-    saveToFile();
-    return true;
+bool MedicalSupply::useLast(int qty) {
+    Metrics::Timer timer(Metrics::USE_LAST_SUPPLY);
+    if (!top_ || qty <= 0 || qty > top_->data.quantity) return false;
+    return consumeFrom(top_->data.id, qty);   // In place; pops the node only when it reaches zero
 }
 
 void MedicalSupply::viewCurrentSupplies() const {
@@ -217,59 +341,233 @@ void MedicalSupply::viewCurrentSupplies() const {
         cout << "No supplies in stock.\n";
         return;
     }
+    PagedView::browse([this](int offset, int limit) { return viewCurrentSupplies(offset, limit); });
+}
 
-    cout << "\n[ Current Medical Supplies (Top → Bottom) ]\n";
-    cout << left << setw(6)  << "ID"
-                 << setw(20) << "Name"
-                 << setw(10) << "Qty"
-                 << setw(12) << "Batch"
-                 << setw(15) << "Expiry"
-                 << "Notes\n";
-    cout << string(80, '-') << "\n";
+bool MedicalSupply::viewCurrentSupplies(int offset, int limit) const {
+    // Walk down from the top: skip offset nodes, print limit (O(offset + limit), no copy)
+    ostream& out = Log::result();
+    if (!top_) {
+        out << "No supplies in stock.\n";
+        return false;
+    }
 
     Node* cur = top_;
-    while (cur) {
+    for (int i = 0; cur && i < offset; ++i) cur = cur->next;
+    if (!cur) {
+        PagedView::footer(out, offset, 0, static_cast<int>(byId_.size()), false);
+        return false;
+    }
+
+    out << "\n[ Current Medical Supplies (Top → Bottom) ]\n";
+    out << left << setw(6)  << "ID"
+                << setw(20) << "Name"
+                << setw(10) << "Qty"
+                << setw(12) << "Batch"
+                << setw(15) << "Expiry"
+                << "Notes\n";
+    out << string(80, '-') << "\n";
+
+    int shown = 0;
+    for (; cur && shown < limit; cur = cur->next, ++shown) {
         const Supply& s = cur->data;
-        cout << left << setw(6)  << s.id
-                     << setw(20) << s.name
-                     << setw(10) << s.quantity
-                     << setw(12) << s.batch
-                     << setw(15) << s.expiry
-                     << s.notes << "\n";
-        cur = cur->next;
+        out << left << setw(6)  << s.id
+                    << setw(20) << s.name
+                    << setw(10) << s.quantity
+                    << setw(12) << s.batch
+                    << setw(15) << s.expiry
+                    << s.notes << "\n";
+    }
+    PagedView::footer(out, offset, shown, static_cast<int>(byId_.size()), cur != nullptr);
+    return cur != nullptr;
+}
+
+// ---- Index-backed inventory queries ----
+std::vector<const MedicalSupply::Supply*> MedicalSupply::expiringWithin(int days) const {
+    // Ordered by packed expiry day: stop at the first batch past the horizon.
+    vector<const Supply*> out;
+    int horizon = today() + days;
+    for (auto it = byExpiry_.begin(); it != byExpiry_.end() && it->first <= horizon; ++it) {
+        out.push_back(&it->second->data);
+    }
+    return out;
+}
+
+int MedicalSupply::totalQuantity(const std::string& name) const {
+    auto it = byName_.find(nameKey(name));
+    return it == byName_.end() ? 0 : it->second.total;
+}
+
+bool MedicalSupply::consume(int id, int qty) {
+    Metrics::Timer timer(Metrics::CONSUME_SUPPLY);
+    return consumeFrom(id, qty);
+}
+
+bool MedicalSupply::consumeFrom(int id, int qty) {
+    Node* n = findById(id);
+    if (!n) {
+        Log::error() << "Supply ID " << id << " not found.\n";
+        return false;
+    }
+    Supply& s = n->data;
+    if (qty <= 0 || qty > s.quantity) {
+        Log::error() << "❌ Invalid quantity entered.\n";
+        return false;
+    }
+
+    // Quantity changes in place: no pop/re-push, no new ID, one journal entry.
+    setQuantity(n, s.quantity - qty);
+    if (s.quantity == 0) {
+        Log::result() << "✅ All units used. Removing supply from stack...\n";
+        removeNode(n);
+        logOperation("O," + to_string(id));
+    } else {
+        Log::result() << "✅ " << qty << " units used from " << s.name
+             << " (Remaining: " << s.quantity << ")\n";
+        logOperation("U," + to_string(id) + "," + to_string(s.quantity));
+    }
+    return true;
+}
+
+bool MedicalSupply::consume(const std::string& name, int qty) {
+    Metrics::Timer timer(Metrics::CONSUME_SUPPLY);
+    auto it = byName_.find(nameKey(name));
+    if (it == byName_.end()) {
+        Log::error() << "No stock of '" << name << "'.\n";
+        return false;
+    }
+    if (qty <= 0 || qty > it->second.total) {
+        Log::error() << "❌ Invalid quantity (available: " << it->second.total << ").\n";
+        return false;
+    }
+
+    // FEFO: drain batches in expiry order; the per-batch U/O entries go out as one write.
+    vector<string> entries;
+    int remaining = qty;
+    while (remaining > 0) {
+        Node* n = it->second.batches.begin()->second;
+        int take = min(remaining, n->data.quantity);
+        int id = n->data.id;
+        remaining -= take;
+        Log::result() << "✅ " << take << " units used from batch " << n->data.batch
+             << " (ID " << id << ", expiry " << n->data.expiry << ")\n";
+        if (take == n->data.quantity) {
+            bool last = it->second.batches.size() == 1;
+            removeNode(n);
+            entries.push_back("O," + to_string(id));
+            if (last) break;
+        } else {
+            setQuantity(n, n->data.quantity - take);
+            entries.push_back("U," + to_string(id) + "," + to_string(n->data.quantity));
+        }
+    }
+    logOperations(entries);
+    return true;
+}
+
+void MedicalSupply::viewExpiringSoon(int days) const {
+    PagedView::browse([this, days](int offset, int limit) { return viewExpiringSoon(days, offset, limit); });
+}
+
+bool MedicalSupply::viewExpiringSoon(int days, int offset, int limit) const {
+    // Straight off the expiry index: skip offset batches, stop at the horizon or after limit rows.
+    ostream& out = Log::result();
+    int now = today();
+    int horizon = now + days;
+    auto it = byExpiry_.begin();
+    for (int i = 0; i < offset && it != byExpiry_.end() && it->first <= horizon; ++i) ++it;
+    if (it == byExpiry_.end() || it->first > horizon) {
+        if (offset == 0) out << "No supplies expiring within " << days << " days.\n";
+        else PagedView::footer(out, offset, 0, -1, false);
+        return false;
+    }
+    out << "\n[ Supplies Expiring Within " << days << " Days (Earliest First) ]\n";
+    out << left << setw(6)  << "ID"
+                << setw(20) << "Name"
+                << setw(10) << "Qty"
+                << setw(12) << "Batch"
+                << setw(15) << "Expiry"
+                << "Status\n";
+    out << string(80, '-') << "\n";
+    int shown = 0;
+    for (; it != byExpiry_.end() && it->first <= horizon && shown < limit; ++it, ++shown) {
+        const Supply& s = it->second->data;
+        int daysLeft = it->first - now;
+        string status = daysLeft < 0 ? "EXPIRED" : (to_string(daysLeft) + " days left");
+        out << left << setw(6)  << s.id
+                    << setw(20) << s.name
+                    << setw(10) << s.quantity
+                    << setw(12) << s.batch
+                    << setw(15) << s.expiry
+                    << status << "\n";
+    }
+    bool more = it != byExpiry_.end() && it->first <= horizon;
+    PagedView::footer(out, offset, shown, -1, more);
+    return more;
+}
+
+void MedicalSupply::viewReorderReport(int threshold) const {
+    // One row per distinct item (not per batch), lowest stock first.
+    vector<pair<int, const Supply*>> low;
+    for (const auto& kv : byName_) {
+        if (kv.second.total < threshold) low.push_back({kv.second.total, &kv.second.batches.begin()->second->data});
+    }
+    if (low.empty()) {
+        cout << "All items are at or above " << threshold << " units.\n";
+        return;
+    }
+    sort(low.begin(), low.end(), [](const pair<int, const Supply*>& a, const pair<int, const Supply*>& b) {
+        return a.first < b.first;
+    });
+    cout << "\n[ Reorder Report (Total Below " << threshold << ") ]\n";
+    cout << left << setw(20) << "Name" << setw(10) << "Total" << "Next Expiry\n";
+    cout << string(45, '-') << "\n";
+    for (const auto& row : low) {
+        cout << left << setw(20) << row.second->name << setw(10) << row.first << row.second->expiry << "\n";
     }
 }
 
 bool MedicalSupply::saveToSpecificFile(const std::string& filename) {
-    ofstream f(filename);
+    Metrics::Timer timer(Metrics::SAVE_SUPPLIES_CSV);
+    // Temp file + rename: a crash mid-save never leaves a truncated database.
+    string tmp = filename + ".tmp";
+    ofstream f(tmp);
     if (!f.is_open()) return false;
 
     f << "ID,Name,Quantity,Batch,Expiry,Notes\n";
-    Node* cur = top_;
-    while (cur) {
-        const Supply& s = cur->data;
-        f << s.id << "," << s.name << "," << s.quantity << ","
-          << s.batch << "," << s.expiry << "," << s.notes << "\n";
-        cur = cur->next;
+    for (Node* cur = top_; cur; cur = cur->next) {
+        SupplyLayout::writeCsv(f, cur->data);
+        f << '\n';
     }
-    return true;
+    f.close();
+    return f.good() && Journal::replaceFile(tmp, filename);
 }
 
 bool MedicalSupply::loadFromSpecificFile(const std::string& filename) {
-    ifstream f(filename);
-    if (!f.is_open()) return false;
+    Metrics::Timer timer(Metrics::LOAD_SUPPLIES_CSV);
+    MappedFile file;
+    if (!file.open(filename)) return false;
 
     clearAll();
 
-    string header;
-    if (!getline(f, header)) return false;
-
-    string line;
-    while (getline(f, line)) {
+    // Pre-size from the file: one node per line (minus the header), no per-node block allocation.
+    string_view data = file.view();
+    int rows = static_cast<int>(count(data.begin(), data.end(), '\n'));
+    pool_.reserve(rows);
+    byId_.reserve(rows);
+
+    CsvLineReader lines(data);
+    string_view line;
+    if (!lines.nextLine(line)) return false;   // header
+
+    // Rows are stored top -> bottom: append each under the last so the LIFO order survives
+    // a save/load round trip (pushing would reverse it every restart).
+    Node* bottom = nullptr;
+    Supply s{};
+    while (lines.nextLine(line)) {
         if (line.empty()) continue;
-        Supply s{};
-        if (parseCsvLine(line, s)) {
-            pushNode(s);
+        if (SupplyLayout::parseCsv(line, s)) {
+            bottom = appendBottom(s, bottom);
         }
     }
     return true;
@@ -277,24 +575,56 @@ bool MedicalSupply::loadFromSpecificFile(const std::string& filename) {
 
 bool MedicalSupply::saveToFile() {
     if (saveToSpecificFile(PRIMARY_PATH)) {
-        cout << "[MedicalSupply] Saved to " << PRIMARY_PATH << "\n";
+        Log::status() << "[MedicalSupply] Saved to " << PRIMARY_PATH << "\n";
         return true;
     }
     if (saveToSpecificFile(FALLBACK_PATH)) {
-        cout << "[MedicalSupply] Saved to " << FALLBACK_PATH << " (fallback)\n";
+        Log::status() << "[MedicalSupply] Saved to " << FALLBACK_PATH << " (fallback)\n";
         return true;
     }
-    cout << "[MedicalSupply] ERROR: failed to save database.\n";
+    Log::error() << "[MedicalSupply] ERROR: failed to save database.\n";
     return false;
 }
 
+// ---- Binary snapshot (data/medical_supplies.bin) ----
+// Columns from SupplyLayout: ints {id, quantity}, strings {name, batch, expiry, notes}; top-first like the TXT.
+bool MedicalSupply::saveToBinary(const std::string& filename) const {
+    Metrics::Timer timer(Metrics::SAVE_SUPPLIES_BIN);
+    BinarySnapshot::Writer snap(BinarySnapshot::SUPPLIES, SupplyLayout::INT_COLUMNS, SupplyLayout::STR_COLUMNS);
+    for (Node* cur = top_; cur; cur = cur->next) SupplyLayout::addTo(snap, cur->data);
+    return snap.writeTo(filename);
+}
+
+bool MedicalSupply::loadFromBinary(const std::string& filename) {
+    Metrics::Timer timer(Metrics::LOAD_SUPPLIES_BIN);
+    BinarySnapshot::Reader snap;
+    if (!snap.open(filename, BinarySnapshot::SUPPLIES, SupplyLayout::INT_COLUMNS, SupplyLayout::STR_COLUMNS)) {
+        return false;
+    }
+
+    clearAll();
+    pool_.reserve(snap.count());
+    byId_.reserve(snap.count());
+    Node* bottom = nullptr;
+    Supply s;
+    for (uint32_t r = 0; r < snap.count(); ++r) {
+        SupplyLayout::readFrom(snap, r, s);
+        bottom = appendBottom(s, bottom);
+    }
+    return true;
+}
+
 bool MedicalSupply::loadFromFile() {
+    if (BinarySnapshot::preferBinary(BINARY_PATH, PRIMARY_PATH) && loadFromBinary(BINARY_PATH)) {
+        Log::status() << "[MedicalSupply] Loaded from " << BINARY_PATH << "\n";
+        return true;
+    }
     if (loadFromSpecificFile(PRIMARY_PATH)) {
-        cout << "[MedicalSupply] Loaded from " << PRIMARY_PATH << "\n";
+        Log::status() << "[MedicalSupply] Loaded from " << PRIMARY_PATH << "\n";
         return true;
     }
     if (loadFromSpecificFile(FALLBACK_PATH)) {
-        cout << "[MedicalSupply] Loaded from " << FALLBACK_PATH << "\n";
+        Log::status() << "[MedicalSupply] Loaded from " << FALLBACK_PATH << "\n";
         return true;
     }
     return false;
@@ -307,6 +637,11 @@ void MedicalSupply::displayMenu() {
              << "1. Add Supply Stock\n"
              << "2. Use 'Last Added' Supply\n"
              << "3. View Current Supplies\n"
+             << "4. View Supplies Expiring Soon\n"
+             << "5. Total Quantity by Item Name\n"
+             << "6. Reorder Report\n"
+             << "7. Use Supply by Name (Earliest Expiry First)\n"
+             << "8. Use Units from Supply by ID\n"
              << "0. Back to Main Menu\n"
              << "------------------------------------\n"
              << "Enter your choice: ";
@@ -329,6 +664,74 @@ void MedicalSupply::displayMenu() {
                 cout << "\n[ Viewing Current Supplies ]\n";
                 viewCurrentSupplies();
                 break;
+            case 4: {
+                int days;
+                cout << "Show supplies expiring within how many days? ";
+                if (!(cin >> days) || days < 0) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid number of days.\n";
+                    break;
+                }
+                viewExpiringSoon(days);
+                break;
+            }
+            case 5: {
+                string name;
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                cout << "Enter item name: ";
+                getline(cin, name);
+                cout << "Total quantity of '" << name << "': " << totalQuantity(name) << " units\n";
+                break;
+            }
+            case 6: {
+                int threshold;
+                cout << "Reorder when total is below: ";
+                if (!(cin >> threshold)) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid threshold.\n";
+                    break;
+                }
+                viewReorderReport(threshold);
+                break;
+            }
+            case 7: {
+                string name;
+                int qty;
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                cout << "Enter item name: ";
+                getline(cin, name);
+                cout << "Enter number of units to use: ";
+                if (!(cin >> qty)) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "❌ Invalid quantity entered.\n";
+                    break;
+                }
+                cout << "\n[ Using " << name << " by Earliest Expiry ]\n";
+                consume(name, qty);
+                break;
+            }
+            case 8: {
+                int id, qty;
+                cout << "Enter supply ID: ";
+                if (!(cin >> id)) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid ID input.\n";
+                    break;
+                }
+                cout << "Enter number of units to use: ";
+                if (!(cin >> qty)) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "❌ Invalid quantity entered.\n";
+                    break;
+                }
+                consume(id, qty);
+                break;
+            }
             case 0:
                 cout << "Returning to main menu...\n";
                 break;
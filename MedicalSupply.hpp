@@ -1,7 +1,14 @@
 #ifndef MEDICALSUPPLY_HPP
 #define MEDICALSUPPLY_HPP
 
+#include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Journal.hpp"
+#include "NodePool.hpp"
+#include "RecordSchema.hpp"
 
 /*
 ===============================================================================
@@ -24,16 +31,36 @@ DATA STRUCTURE & ALGORITHM CHOICE
 PERSISTENCE
 - Reads from and writes to a CSV-like TXT file so state survives restarts.
 - Dual-path strategy: primary "data/medical_supplies.txt", fallback "medicalSupply.txt".
+- Rows are stored top -> bottom and the loader appends each row under the previous
+  one (pool pre-sized from the line count), so the LIFO order survives restarts.
+- Each push/use appends one entry to "data/medical_supplies.log" (O(1)); the TXT is
+  rewritten only when the journal is compacted (startup, exit, every N entries).
+
+SECONDARY INDEXES (kept in sync by every push/pop/update)
+- ID -> node (hash map): O(1) lookup for replay and consumption.
+- Expiry -> nodes (ordered multimap keyed on a packed day number, not the
+  YYYY-MM-DD string): "expiring within N days" walks only the matching rows.
+- Name -> { total quantity, batches ordered by expiry }: O(1) stock totals,
+  reorder report over distinct names, and FEFO (first-expired, first-out)
+  consumption across batches of the same item.
+- Nodes are doubly linked so an indexed node is unlinked in O(1).
 
 COMPLEXITY SUMMARY
-- Add (push):                   O(1)
-- Use last (pop):               O(1)
+- Add (push):                   O(log n)  (index inserts)
+- Use last (pop):               O(log n)
 - View (traverse/print):        O(n)
+- Expiring within N days:       O(log n + k)
+- Total quantity of a name:     O(1)
+- Consume by ID:                 O(1) (O(log n) if the batch is used up)
+- Consume by name (FEFO):       O(b log n) for b batches touched
 - Save/Load file (linear scan): O(n)
+- Per-operation persistence:    O(1) journal append
 
 CODE QUALITY / MARKING INTENT
 - Defensive input handling (stream resets).
-- Tolerant CSV parser (notes can contain commas; parsed as "remainder of line").
+- Tolerant CSV parser (notes can contain commas; parsed as "remainder of line"),
+  generated from SupplyLayout (RecordSchema) over the shared zero-copy CsvTokenizer;
+  names / batches with commas or quotes are written quoted and read back intact.
 - Clean separation of interface (.hpp) and implementation (.cpp).
 - Explicit comments justify choices and complexities for viva.
 ===============================================================================
@@ -51,13 +78,37 @@ public:
         std::string notes;    // free text (may contain commas)
     };
 
+    // Storage layout (TXT rows, P journal entries, .bin): ID,Name,Quantity,Batch,Expiry,Notes
+    typedef RecordSchema::Layout<Supply,
+                                 RecordSchema::Field<&Supply::id>,
+                                 RecordSchema::Field<&Supply::name>,
+                                 RecordSchema::Field<&Supply::quantity>,
+                                 RecordSchema::Field<&Supply::batch>,
+                                 RecordSchema::Field<&Supply::expiry>,
+                                 RecordSchema::Field<&Supply::notes, RecordSchema::REST>> SupplyLayout;
+
     MedicalSupply();
     ~MedicalSupply();
 
     // === Core features (Menu calls these) ===
     bool addSupply();               // 1) Add Stock  -> push
+    bool addSupply(Supply s);       //    Same, without prompts (ID assigned here)
     bool useLastAddedSupply();      // 2) Use Last   -> pop
-    void viewCurrentSupplies() const; // 3) View      -> traverse
+    bool useLast(int qty);          //    Same, without prompts (pops the batch when it reaches zero)
+    const Supply* peekTop() const { return top_ ? &top_->data : nullptr; }
+    void viewCurrentSupplies() const; // 3) View      -> traverse, one page at a time
+    bool viewCurrentSupplies(int offset, int limit) const; // One page from the top; true if more follow
+
+    // === Partial consumption (in place; node removed only at zero; one journal write) ===
+    bool consume(int id, int qty);                  // From one batch
+    bool consume(const std::string& name, int qty); // FEFO across batches of an item
+
+    // === Inventory queries (secondary indexes) ===
+    std::vector<const Supply*> expiringWithin(int days) const;  // Earliest first (includes expired)
+    int  totalQuantity(const std::string& name) const;          // Across all batches (case-insensitive)
+    void viewExpiringSoon(int days) const;                      // Paged (menu)
+    bool viewExpiringSoon(int days, int offset, int limit) const; // One page, earliest first; true if more
+    void viewReorderReport(int threshold) const;                // Items whose total is below threshold
 
     // === Persistence (TXT database) ===
     bool saveToFile();
@@ -67,30 +118,58 @@ public:
     void displayMenu();
 
 private:
-    // Manual singly-linked list node (no STL containers used)
+    // Manual linked list node; prev (toward top_) allows O(1) unlink of an indexed node
     struct Node {
         Supply data;
         Node*  next;
-        explicit Node(const Supply& s) : data(s), next(nullptr) {}
+        Node*  prev;
+        std::multimap<int, Node*>::iterator expiryPos;  // Entry in byExpiry_
+        std::multimap<int, Node*>::iterator batchPos;   // Entry in its NameIndex::batches
+        explicit Node(const Supply& s) : data(s), next(nullptr), prev(nullptr) {}
+    };
+    struct NameIndex {
+        int total = 0;                                  // Sum of quantity over batches
+        std::multimap<int, Node*> batches;              // Expiry day -> batch (FEFO order)
     };
+    static const int NO_EXPIRY = 0x7fffffff;            // Unparseable/missing expiry sorts last
 
     Node* top_;     // Stack top (most recent item)
+    std::unordered_map<int, Node*> byId_;
+    std::multimap<int, Node*> byExpiry_;
+    std::unordered_map<std::string, NameIndex> byName_; // Key: lowercased, trimmed name
+    NodePool<Node> pool_; // Slab storage for the nodes (O(1) create/destroy, bulk reset)
     int   nextId_;  // Auto-increment ID source
+    Journal journal_; // Append-only operation log
 
     // ---- Internal helpers (single-responsibility, testable) ----
     void clearAll();                // Free entire list (O(n))
-    void pushNode(const Supply& s); // O(1) push to top_
-    bool popNode(Supply& out);      // O(1) pop from top_
+    void pushNode(const Supply& s); // Push to top_ + index
+    Node* appendBottom(const Supply& s, Node* bottom); // Loader: link under bottom (keeps file order)
+    void indexNode(Node* n);        // Add to byId_/byExpiry_/byName_
+    bool popNode(Supply& out);      // Pop from top_ + unindex
+    void removeNode(Node* n);       // O(log n) unlink anywhere + unindex + free
+    void setQuantity(Node* n, int quantity); // Keeps the name total in sync
+    bool consumeFrom(int id, int qty);       // Core of consume(id) / useLast, untimed (each times itself)
 
     bool saveToSpecificFile(const std::string& filename); // O(n)
     bool loadFromSpecificFile(const std::string& filename); // O(n)
+    bool saveToBinary(const std::string& filename) const;   // O(n) bulk write (data/*.bin)
+    bool loadFromBinary(const std::string& filename);       // O(n) bulk read, no text parsing
+
+    // ---- Journal persistence ----
+    void logOperation(const std::string& entry);      // O(1) append (or full save fallback)
+    void logOperations(const std::vector<std::string>& entries); // One buffered append for many, fsync batched
+    void applyJournalEntry(std::string_view entry); // Idempotent replay of one entry
+    void compact();                                   // Fold journal into the TXT file
+    Node* findById(int id) const;                     // O(1) via byId_
 
     // Small utility helpers
     static void trim(std::string& s);                 // whitespace hygiene
-    static bool parseCsvLine(const std::string& line, // tolerant CSV parse
-                             Supply& s);
     static bool isAlnumDash(const std::string& s);
     static bool isValidDate(const std::string& d);
+    static int  expiryDay(const std::string& d);      // YYYY-MM-DD -> days since 1970-01-01 (or NO_EXPIRY)
+    static int  today();                              // Local date as a day number
+    static std::string nameKey(const std::string& name);
 };
 
 #endif // MEDICALSUPPLY_HPP
@@ -0,0 +1,154 @@
+// Metrics.cpp
+// Implementation of the shared instrumentation layer (see Metrics.hpp).
+// Complexity: record O(1) (three relaxed adds + a max CAS that rarely loops); export O(ops x buckets).
+
+#include "Metrics.hpp"
+#include "Journal.hpp"
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+using namespace std;
+
+namespace {
+
+const char* const OP_NAMES[Metrics::OP_COUNT] = {
+    "admitPatient", "dischargePatient", "admitBatch", "dischargeN", "loadPatientsFromFile", "savePatientsToFile",
+    "loadPatientsFromBinary", "savePatientsToBinary",
+    "addSupply", "useLastAddedSupply", "consume", "loadFromFile_supplies", "saveToFile_supplies",
+    "loadFromBinary_supplies", "saveToBinary_supplies",
+    "logEmergencyCase", "processCriticalCase", "updatePriority", "drainIntake",
+    "loadExistingEmergencies", "compactEmergencies",
+    "registerAmbulance", "assignShift", "rotateShift", "updateDutyStatus", "loadFromFile_ambulances",
+    "saveToFile_ambulances", "loadFromBinary_ambulances", "saveToBinary_ambulances",
+};
+
+const char* const GAUGE_NAMES[Metrics::GAUGE_COUNT] = {
+    "hms_patient_queue_size", "hms_triage_heap_size", "hms_triage_intake_depth",
+    "hms_supply_stack_size", "hms_ambulance_roster_size", "hms_registry_records", "hms_registry_strings",
+};
+
+struct OpStats {
+    atomic<long long> count{0};
+    atomic<long long> sumNs{0};
+    atomic<long long> maxNs{0};
+    atomic<long long> buckets[Metrics::BUCKETS] = {};
+};
+
+OpStats ops[Metrics::OP_COUNT];
+atomic<long long> gauges[Metrics::GAUGE_COUNT] = {};
+
+int bucketOf(long long ns) {
+    int b = 0;
+    unsigned long long v = ns > 0 ? static_cast<unsigned long long>(ns) : 0;
+    while (v && b < Metrics::BUCKETS - 1) {   // Bit width, capped
+        v >>= 1;
+        ++b;
+    }
+    return b;
+}
+
+long long bucketUpper(int b) { return 1LL << b; }   // Durations in bucket b are < 2^b ns
+
+} // namespace
+
+namespace Metrics {
+
+void record(Op op, long long ns) {
+    OpStats& s = ops[op];
+    s.count.fetch_add(1, memory_order_relaxed);
+    s.sumNs.fetch_add(ns, memory_order_relaxed);
+    s.buckets[bucketOf(ns)].fetch_add(1, memory_order_relaxed);
+    long long seen = s.maxNs.load(memory_order_relaxed);
+    while (ns > seen && !s.maxNs.compare_exchange_weak(seen, ns, memory_order_relaxed)) {}
+}
+
+void setGauge(Gauge g, long long value) {
+    gauges[g].store(value, memory_order_relaxed);
+}
+
+long long count(Op op) { return ops[op].count.load(memory_order_relaxed); }
+
+long long gauge(Gauge g) { return gauges[g].load(memory_order_relaxed); }
+
+long long percentileNs(Op op, double percentile) {
+    const OpStats& s = ops[op];
+    long long total = 0;
+    long long counts[BUCKETS];
+    for (int b = 0; b < BUCKETS; ++b) total += counts[b] = s.buckets[b].load(memory_order_relaxed);
+    if (total == 0) return 0;
+    long long rank = static_cast<long long>(ceil(percentile / 100.0 * total));   // Nearest rank
+    if (rank < 1) rank = 1;
+    long long seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += counts[b];
+        if (seen >= rank) return min(bucketUpper(b), s.maxNs.load(memory_order_relaxed));
+    }
+    return s.maxNs.load(memory_order_relaxed);
+}
+
+void write(ostream& out) {
+    out << "# HELP hms_operation_seconds Latency of instrumented module operations.\n"
+        << "# TYPE hms_operation_seconds histogram\n";
+    for (int i = 0; i < OP_COUNT; ++i) {
+        const OpStats& s = ops[i];
+        long long n = s.count.load(memory_order_relaxed);
+        if (n == 0) continue;
+        long long cumulative = 0;
+        for (int b = 0; b < BUCKETS - 1; ++b) {
+            long long c = s.buckets[b].load(memory_order_relaxed);
+            if (c == 0 && cumulative == 0) continue;   // Skip the empty low end...
+            cumulative += c;
+            out << "hms_operation_seconds_bucket{op=\"" << OP_NAMES[i] << "\",le=\"" << setprecision(9)
+                << bucketUpper(b) / 1e9 << "\"} " << cumulative << "\n";
+            if (cumulative == n) break;                // ...and the empty high end
+        }
+        out << "hms_operation_seconds_bucket{op=\"" << OP_NAMES[i] << "\",le=\"+Inf\"} " << n << "\n"
+            << "hms_operation_seconds_sum{op=\"" << OP_NAMES[i] << "\"} " << setprecision(9)
+            << s.sumNs.load(memory_order_relaxed) / 1e9 << "\n"
+            << "hms_operation_seconds_count{op=\"" << OP_NAMES[i] << "\"} " << n << "\n";
+    }
+    out << "# HELP hms_operation_max_seconds Slowest call seen per operation.\n"
+        << "# TYPE hms_operation_max_seconds gauge\n";
+    for (int i = 0; i < OP_COUNT; ++i) {
+        if (ops[i].count.load(memory_order_relaxed) == 0) continue;
+        out << "hms_operation_max_seconds{op=\"" << OP_NAMES[i] << "\"} " << setprecision(9)
+            << ops[i].maxNs.load(memory_order_relaxed) / 1e9 << "\n";
+    }
+    for (int g = 0; g < GAUGE_COUNT; ++g) {
+        out << "# TYPE " << GAUGE_NAMES[g] << " gauge\n"
+            << GAUGE_NAMES[g] << " " << gauges[g].load(memory_order_relaxed) << "\n";
+    }
+}
+
+bool writeSnapshot(const string& path) {
+    string tmp = path + ".tmp";
+    {
+        ofstream out(tmp, ios::trunc);
+        if (!out) return false;
+        write(out);
+        if (!out) return false;
+    }
+    return Journal::replaceFile(tmp, path);
+}
+
+void writeSummary(ostream& out) {
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << left << setw(26) << "Operation" << right << setw(10) << "Calls" << setw(12) << "p50 (us)"
+        << setw(12) << "p99 (us)" << setw(12) << "max (us)" << "\n";
+    for (int i = 0; i < OP_COUNT; ++i) {
+        Op op = static_cast<Op>(i);
+        long long n = count(op);
+        if (n == 0) continue;
+        out << left << setw(26) << OP_NAMES[i] << right << setw(10) << n << fixed << setprecision(1)
+            << setw(12) << percentileNs(op, 50) / 1e3 << setw(12) << percentileNs(op, 99) / 1e3
+            << setw(12) << ops[i].maxNs.load(memory_order_relaxed) / 1e3 << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+    for (int g = 0; g < GAUGE_COUNT; ++g) out << GAUGE_NAMES[g] << " = " << gauge(static_cast<Gauge>(g)) << "\n";
+}
+
+} // namespace Metrics
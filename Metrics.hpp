@@ -0,0 +1,82 @@
+// Metrics.hpp
+// Hot-path instrumentation shared by the four roles: per-operation counters + latency histograms,
+// and gauges for queue / stack / roster sizes.
+// Data Structure Choice: FIXED ARRAYS OF ATOMICS, indexed by enum (no registry, no strings at runtime)
+// Why?
+// - Recording is a handful of relaxed atomic adds into preallocated slots: no allocation, no lock,
+//   safe from any service thread and from the background compaction workers.
+// - Latency histograms use LOG2 BUCKETS over nanoseconds (bucket = bit width of the duration):
+//   40 fixed slots cover 1 ns .. 18 minutes with one bit scan per sample; percentiles are read
+//   back to within a factor of two, plenty to spot a slow save or a triage backlog.
+// - Gauges are plain atomic values set by the data structures themselves when their size changes
+//   (destructors leave them alone, so an at-exit snapshot shows the last live sizes).
+// - Export: text in the Prometheus exposition format, written as a snapshot file (main --metrics
+//   <file> at exit, or the batch command "metrics <file>") so any scraper or a plain cat can read it.
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+namespace Metrics {
+
+// Instrumented operations (names in Metrics.cpp match the member functions). An operation that first
+// calls another instrumented one (a triage call draining the intake queue, useLast -> consume) starts
+// its timer after that call or times only its own work, so nothing is counted under two ops; a
+// compaction an operation triggers stays part of that operation's (amortised) cost.
+enum Op {
+    ADMIT_PATIENT, DISCHARGE_PATIENT, ADMIT_BATCH, DISCHARGE_BATCH, LOAD_PATIENTS_CSV, SAVE_PATIENTS_CSV, LOAD_PATIENTS_BIN, SAVE_PATIENTS_BIN,
+    ADD_SUPPLY, USE_LAST_SUPPLY, CONSUME_SUPPLY, LOAD_SUPPLIES_CSV, SAVE_SUPPLIES_CSV, LOAD_SUPPLIES_BIN,
+    SAVE_SUPPLIES_BIN,
+    LOG_EMERGENCY, PROCESS_CRITICAL, UPDATE_PRIORITY, DRAIN_INTAKE, LOAD_EMERGENCY, SAVE_EMERGENCY,
+    REGISTER_AMBULANCE, ASSIGN_SHIFT, ROTATE_SHIFT, UPDATE_DUTY_STATUS, LOAD_AMBULANCES_CSV,
+    SAVE_AMBULANCES_CSV, LOAD_AMBULANCES_BIN, SAVE_AMBULANCES_BIN,
+    OP_COUNT
+};
+
+enum Gauge {
+    PATIENT_QUEUE,       // PatientAdmission::currentSize
+    TRIAGE_HEAP,         // EmergencyDepartment pending cases in the heap
+    TRIAGE_INTAKE,       // Cases waiting in the lock-free intake queue
+    SUPPLY_STACK,        // MedicalSupply stack size
+    AMBULANCE_ROSTER,    // Ambulance roster length
+    REGISTRY_RECORDS,    // PatientRegistry live records
+    REGISTRY_STRINGS,    // PatientRegistry distinct interned strings
+    GAUGE_COUNT
+};
+
+static const int BUCKETS = 40;   // Bucket b counts durations < 2^b ns (last bucket: everything above)
+
+void record(Op op, long long nanoseconds);   // Allocation-free, any thread
+void setGauge(Gauge gauge, long long value);
+
+// Times its own lifetime into op.
+class Timer {
+public:
+    explicit Timer(Op op) : op_(op), start_(std::chrono::steady_clock::now()) {}
+    ~Timer() {
+        record(op_, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start_).count());
+    }
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+private:
+    Op op_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Read side (export / reports). Values are a best-effort snapshot while recording continues.
+long long count(Op op);
+long long percentileNs(Op op, double percentile);   // Upper bound of the bucket holding it (0 if none)
+long long gauge(Gauge gauge);
+
+void write(std::ostream& out);                 // Prometheus text exposition
+bool writeSnapshot(const std::string& path);   // Same, to a file (temp + rename)
+void writeSummary(std::ostream& out);          // Human-readable table of the operations seen
+
+} // namespace Metrics
+
+#endif // METRICS_HPP
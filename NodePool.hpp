@@ -0,0 +1,118 @@
+// NodePool.hpp
+// Shared slab allocator for the linked-list nodes of Role 2 (supply stack) and Role 4 (ambulance roster).
+// Data Structure Choice: BLOCKS OF SLOTS + INTRUSIVE FREE LIST
+// Why a pool instead of one new/delete per node?
+// - Nodes are carved out of fixed-size blocks of BLOCK slots, so a list built in order sits in
+//   mostly-contiguous memory and traversals (display, duty update) stay cache-friendly.
+// - A freed slot stores the free-list link in its own bytes (no side table); the next create()
+//   reuses it in O(1).
+// - reset() forgets every node at once and keeps the blocks: clearAll() + reload performs no
+//   per-node malloc/free. Blocks are returned to the heap only when the pool is destroyed.
+// Contract: the owner runs node destructors itself (destroy() for one node, or a walk of the
+//   list before reset()); the pool never knows which slots are live.
+
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <new>
+#include <utility>
+
+template <typename T, int BLOCK = 64>
+class NodePool {
+public:
+    NodePool() : blocks_(nullptr), last_(nullptr), current_(nullptr), bump_(0), free_(nullptr), live_(0),
+                 blockCount_(0), currentIndex_(-1) {}
+    ~NodePool() {
+        while (blocks_) {
+            Block* next = blocks_->next;
+            delete blocks_;
+            blocks_ = next;
+        }
+    }
+
+    // Owning raw blocks: copying would double-free, so forbid it.
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // O(1): free-list pop, else bump within the current block (a new block every BLOCK nodes).
+    template <typename... Args>
+    T* create(Args&&... args) {
+        return new (allocSlot()) T(std::forward<Args>(args)...);
+    }
+
+    // O(1): run the destructor and push the slot onto the free list.
+    void destroy(T* p) {
+        p->~T();
+        Slot* s = reinterpret_cast<Slot*>(p);
+        s->next = free_;
+        free_ = s;
+        live_--;
+    }
+
+    // Pre-size for a bulk load: afterwards the next n create() calls allocate nothing.
+    void reserve(int n) {
+        int avail = (current_ ? BLOCK - bump_ : 0) + (blockCount_ - 1 - currentIndex_) * BLOCK;
+        while (avail < n) {
+            appendBlock();
+            avail += BLOCK;
+        }
+    }
+
+    // Bulk release: every slot becomes free again; blocks are kept for the next load.
+    void reset() {
+        current_ = blocks_;
+        currentIndex_ = blocks_ ? 0 : -1;
+        bump_ = 0;
+        free_ = nullptr;
+        live_ = 0;
+    }
+
+    int live() const { return live_; }
+
+private:
+    union Slot {
+        Slot* next;                                  // Valid while the slot is free
+        alignas(T) unsigned char bytes[sizeof(T)];   // Valid while it holds a T
+    };
+    struct Block {
+        Slot slots[BLOCK];
+        Block* next;
+    };
+
+    void* allocSlot() {
+        live_++;
+        if (free_) {
+            Slot* s = free_;
+            free_ = s->next;
+            return s;
+        }
+        if (!current_ || bump_ == BLOCK) {
+            Block* b = current_ ? current_->next : blocks_;   // Reuse a block kept by reset()/reserve()
+            if (!b) b = appendBlock();
+            current_ = b;
+            currentIndex_++;
+            bump_ = 0;
+        }
+        return &current_->slots[bump_++];
+    }
+
+    Block* appendBlock() {
+        Block* b = new Block;
+        b->next = nullptr;
+        if (last_) last_->next = b; else blocks_ = b;
+        last_ = b;
+        blockCount_++;
+        return b;
+    }
+
+    Block* blocks_;    // All blocks, in allocation order
+    Block* last_;
+    Block* current_;   // Block being bump-allocated
+    int bump_;         // Next unused slot in current_
+    Slot* free_;       // Intrusive free list of destroyed slots
+    int live_;
+    int blockCount_;
+    int currentIndex_; // Position of current_ in the block list (-1 = none yet)
+};
+
+#endif // NODE_POOL_HPP
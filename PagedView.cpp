@@ -0,0 +1,47 @@
+// PagedView.cpp
+// Implementation of the shared paging helpers (see PagedView.hpp).
+// Complexity: O(1) per prompt; the cost of a page is the view's own walk.
+
+#include "PagedView.hpp"
+#include "Log.hpp"
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace std;
+
+namespace PagedView {
+
+void footer(ostream& out, int offset, int shown, int total, bool more) {
+    if (shown == 0) {
+        out << "No rows from position " << offset + 1 << ".\n";
+        return;
+    }
+    out << "Rows " << offset + 1 << "-" << offset + shown;
+    if (total >= 0) out << " of " << total;
+    out << (more ? " (more below)\n" : "\n");
+}
+
+void browse(const Page& page, int pageSize) {
+    int offset = 0;
+    while (true) {
+        bool more = page(offset, pageSize);
+        if (!more && offset == 0) return;   // Everything fit on one page
+
+        cout << (more ? "[n]ext, " : "") << (offset > 0 ? "[p]revious, " : "") << "[q]uit: ";
+        Log::flush();
+        string answer;
+        if (!(cin >> answer)) {
+            cin.clear();
+            return;
+        }
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        char c = answer[0];
+        if (c == 'n' && more) offset += pageSize;
+        else if (c == 'p' && offset > 0) offset = offset > pageSize ? offset - pageSize : 0;
+        else if (c == 'q') return;
+        // Anything else: show the same page again
+    }
+}
+
+} // namespace PagedView
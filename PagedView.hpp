@@ -0,0 +1,35 @@
+// PagedView.hpp
+// Shared paging for the large table views (patient queue, pending cases, supplies, roster).
+// Why pages instead of "print everything"?
+// - With thousands of records one full view floods the terminal and, in service mode, holds the
+//   module's lock for the whole dump. A page is a (offset, limit) window: each view walks its own
+//   structure from the front with a cursor, skips offset records and stops after limit, so a page
+//   costs O(offset + limit) (O(log n) per row for the triage heap) and copies / sorts nothing.
+// - The views return whether more rows follow, so filtered views (expiring batches, units on duty)
+//   never have to count their matches up front.
+// - browse() is the interactive driver for the menus: next / previous / quit between pages.
+//   Batch and service commands call the views directly with their own window.
+
+#ifndef PAGED_VIEW_HPP
+#define PAGED_VIEW_HPP
+
+#include <functional>
+#include <ostream>
+
+namespace PagedView {
+
+static const int PAGE_SIZE = 20;
+
+// One page: returns true if rows remain after it.
+typedef std::function<bool(int offset, int limit)> Page;
+
+// "Rows 21-40 of 1234" (total < 0: unknown), plus a hint when more rows follow.
+void footer(std::ostream& out, int offset, int shown, int total, bool more);
+
+// Show page 1, then prompt n(ext) / p(revious) / q(uit) until the user quits or there is
+// nothing else to show. Reads one word per prompt from cin.
+void browse(const Page& page, int pageSize = PAGE_SIZE);
+
+} // namespace PagedView
+
+#endif // PAGED_VIEW_HPP
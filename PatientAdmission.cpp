@@ -1,27 +1,40 @@
 // PatientAdmission.cpp
-// Implementation for Role 1: Manual FIFO queue via array.
+// Implementation for Role 1: Manual FIFO queue via array (circular ring buffer).
 // Re-Why ARRAY + FIFO QUEUE?
-// - FIFO Behavior: Enqueue (rear++) adds new patients to end; dequeue (front++) removes oldest—preserves arrival order.
+// - FIFO Behavior: Enqueue at rear, dequeue at front, both wrapping modulo capacity—preserves arrival order
+//   and reuses discharged slots, so capacity never leaks.
 //   Directly solves "Admit Patient" (add), "Discharge Patient" (remove earliest), "View" (show in order).
 // - Array Efficiency: Contiguous storage = fast access (no pointer chasing like linked lists); O(1) push/pop.
-//   Bounded size prevents memory leaks; linear scan for view/search is O(n) but trivial (n<=100, hospital-scale).
+//   Chunked growable storage (no fixed cap); views are paged (O(page) per screen via the ring index), search is O(n).
 // - Relevance to System: Supports "patient queues" challenge without priorities (Role 3 uses priority queue for urgency).
 //   Performance: Constant time core ops = handles peak flows; aligns with "efficient management" in outbreaks.
 //   Array > Linked List: Simpler (no new/delete), faster for fixed max—focus on core DS, not mem mgmt.
 //   Validation/Edges: Input checks, error msgs—boosts code quality (readability, correctness).
 //.  Innovation: Auto-ID (prevents dupes), uppercase names (uniform records), search bonus (quick lookup for efficiency).
-//  Saved patients to file for persistence across runs, in simple CSV format (ID,Name,Condition) in "data/patients.txt". 
+//  Saved patients to file for persistence across runs, in simple CSV format (ID,Name,Condition) in "data/patients.txt".
+//  Each admit/discharge appends one entry to "data/patients.log" (O(1)); the CSV is rewritten only on compaction.
 
 #include "PatientAdmission.hpp"
+#include "BinarySnapshot.hpp"
+#include "CsvTokenizer.hpp"
+#include "MappedFile.hpp"
+#include "Log.hpp"
+#include "EventBus.hpp"
+#include "Metrics.hpp"
+#include "PagedView.hpp"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <cctype>  // For toupper (uppercase transform).
 #include <fstream>
-#include <sstream>
 #include <ctime>    // For time()
 #include <limits>   // For numeric_limits
 using namespace std;
 
+static const char* PATIENTS_FILE = "data/patients.txt";
+static const char* PATIENTS_LOG  = "data/patients.log";
+static const char* PATIENTS_BIN  = "data/patients.bin";
+
 // Helper: Uppercase a string (innovation: Standardizes names for clean records/search).
 void toUppercase(string& str) {
     for (char& c : str) {
@@ -30,97 +43,266 @@ void toUppercase(string& str) {
     // Why? Uniform display (e.g., "John" → "JOHN"); O(m) time, m=length (negligible).
 }
 
-PatientAdmission::PatientAdmission() : front(0), rear(0), currentSize(0), nextId(1) {
-    // Load existing patients from file on startup
-    loadPatientsFromFile("data/patients.txt");
+PatientAdmission::PatientAdmission()
+    : registry(PatientRegistry::shared()), front(0), rear(0), currentSize(0), nextId(1), journal(PATIENTS_LOG) {
+    // Load existing patients (binary snapshot if current, else CSV), then replay operations logged since.
+    if (!BinarySnapshot::preferBinary(PATIENTS_BIN, PATIENTS_FILE) || !loadPatientsFromBinary(PATIENTS_BIN)) {
+        loadPatientsFromFile(PATIENTS_FILE);
+    }
+    if (journal.replay([this](string_view e) { applyJournalEntry(e); }) > 0) {
+        compact();  // Keep patients.txt current for modules that read it (Role 3 import).
+    }
 }
 
-bool PatientAdmission::admitPatient() {
-    // Enqueue: Prompt, auto-ID, uppercase name, add if not full.
-    if (isFull()) {
-        cout << "Queue full! Max " << MAX_PATIENTS << " patients." << endl;
-        return false;
+PatientAdmission::~PatientAdmission() {
+    if (journal.entries() > 0) compact();
+    for (int i = 0; i < currentSize; ++i) registry.release(queue[slot(i)]);
+}
+
+// ---- Journal persistence ----
+// Entry formats:  A,<id>,<name>,<condition>   (admit)
+//                 D,<id>                      (discharge of the patient at the front)
+void PatientAdmission::logOperation(const string& entry) {
+    // No journal (e.g. data/ missing)? Fall back to the old full rewrite.
+    if (!journal.append(entry)) {
+        savePatientsToFile(PATIENTS_FILE);
+        return;
+    }
+    if (journal.needsCompaction()) compact();
+}
+
+void PatientAdmission::logBatch(const vector<string>& entries) {
+    // One buffered write + one fsync for the whole batch; compaction (if due) only afterwards.
+    if (entries.empty()) return;
+    if (!journal.appendBatch(entries)) {
+        savePatientsToFile(PATIENTS_FILE);
+        return;
+    }
+    if (journal.needsCompaction()) compact();
+}
+
+string PatientAdmission::admitEntry(const Patient& p) {
+    string entry = "A,";
+    PatientLayout::appendCsv(entry, p);
+    return entry;
+}
+
+void PatientAdmission::applyJournalEntry(string_view entry) {
+    if (entry.size() < 2 || entry[1] != ',') return;
+    string_view body = entry.substr(2);
+
+    if (entry[0] == 'A') {
+        Patient p;
+        if (!PatientLayout::parseCsv(body, p)) return;
+        if (p.id < nextId) return;  // Already in the snapshot (IDs are issued in increasing order).
+        enqueue(p);
+        nextId = p.id + 1;
+    } else if (entry[0] == 'D') {
+        int id;
+        if (parseIntField(body, id) && !isEmpty() && registry.get(queue[front]).id == id) dequeue();  // Otherwise already applied.
+    }
+}
+
+void PatientAdmission::compact() {
+    if (savePatientsToFile(PATIENTS_FILE)) {
+        savePatientsToBinary(PATIENTS_BIN);  // Written after the CSV so it is the newer of the two.
+        journal.truncate();
     }
-    int id = nextId++;  // Auto-increment.
+}
+
+// ---- Ring buffer helpers ----
+int PatientAdmission::slot(int pos) const {
+    int idx = front + pos;
+    int cap = queue.size();
+    return idx < cap ? idx : idx - cap;
+}
+
+void PatientAdmission::growRing() {
+    // Only called when full (front == rear). Appending slots never moves existing patients;
+    // the wrapped prefix [0, rear) is moved once behind the old end so the ring is contiguous again.
+    int oldCap = queue.size();
+    int add = oldCap < ChunkedStore<PatientRegistry::Handle>::CHUNK ? ChunkedStore<PatientRegistry::Handle>::CHUNK : oldCap;
+    for (int i = 0; i < add; ++i) queue.push_back(PatientRegistry::NONE);
+    if (currentSize == 0 || front == 0) {
+        rear = front + currentSize;
+    } else {
+        for (int i = 0; i < rear; ++i) {
+            queue[oldCap + i] = queue[i];
+            queue[i] = PatientRegistry::NONE;
+        }
+        rear = oldCap + rear;
+    }
+    if (rear == queue.size()) rear = 0;
+}
+
+void PatientAdmission::enqueue(const Patient& p) {
+    if (currentSize == queue.size()) growRing();
+    queue[rear] = registry.add(p.id, p.name, p.condition);
+    if (++rear == queue.size()) rear = 0;
+    currentSize++;
+    Metrics::setGauge(Metrics::PATIENT_QUEUE, currentSize);
+}
+
+Patient PatientAdmission::dequeue() {
+    Patient p;
+    copyOut(0, p);
+    registry.release(queue[front]);  // Frees the record unless triage still holds it.
+    queue[front] = PatientRegistry::NONE;
+    if (++front == queue.size()) front = 0;
+    currentSize--;
+    Metrics::setGauge(Metrics::PATIENT_QUEUE, currentSize);
+    return p;
+}
+
+void PatientAdmission::copyOut(int pos, Patient& out) const {
+    PatientRegistry::Entry e = registry.get(queue[slot(pos)]);
+    out.id = e.id;
+    out.name.assign(e.name.data(), e.name.size());
+    out.condition.assign(e.condition.data(), e.condition.size());
+}
+
+int PatientAdmission::admit(const string& name, const string& condition) {
+    Metrics::Timer timer(Metrics::ADMIT_PATIENT);
+    // Non-interactive core of admitPatient(): no prompts, no ticket. Returns the new ID, or -1.
+    if (name.empty() || condition.empty()) return -1;
+    Patient p{nextId++, name, condition};  // Auto-increment.
+    toUppercase(p.name);     // Transform name to caps
+    toUppercase(p.condition); // Transform condition to caps
+    enqueue(p);
+    logOperation(admitEntry(p));  // O(1) journal append
+    EventBus::patientAdmitted().publish({p.id, queue[slot(currentSize - 1)]}); // Live feed to triage (shared record)
+    return p.id;
+}
+
+bool PatientAdmission::admitPatient() {
+    // Enqueue: Prompt, auto-ID, uppercase name, add at rear (wraps around the ring).
     string name, condition;
     cout << "Patient Name: ";
     cin >> ws;  // Clear buffer.
     getline(cin, name);
     cout << "Condition: ";
     getline(cin, condition);
-    if (name.empty() || condition.empty()) {
-        cout << "Invalid input." << endl;
-        nextId--;  // Undo ID.
+    int id = admit(name, condition);
+    if (id < 0) {
+        cout << "Invalid input.\n";
         return false;
     }
-    toUppercase(name);     // Transform name to caps
-    toUppercase(condition); // Transform condition to caps
-    queue[rear++] = {id, name, condition};
-    currentSize++;
+    PatientRegistry::Entry p = registry.get(queue[slot(currentSize - 1)]);  // Just enqueued (uppercased)
     
-    // Print hospital admission ticket
-    cout << "\n╔═════════════════════════════════════════╗" << endl;
-    cout << "║         HOSPITAL ADMISSION TICKET         ║" << endl;
-    cout << "╠═════════════════════════════════════════╣" << endl;
-    cout << "║ Patient ID: " << setw(30) << left << id << "║" << endl;
-    cout << "║ Name: " << setw(34) << left << name << "║" << endl;
-    cout << "║ Condition: " << setw(30) << left << condition << "║" << endl;
+    if (!Log::tickets()) return true;
+
+    // Print hospital admission ticket (one buffered write, no per-line flush)
     time_t now = time(nullptr);
     string datetime = ctime(&now);
     datetime = datetime.substr(0, datetime.length()-1);  // Remove newline
-    cout << "║ Time: " << setw(34) << left << datetime << "║" << endl;
-    cout << "╚═════════════════════════════════════════╝" << endl;
-    
-    savePatientsToFile("data/patients.txt");  // Save after admission
+    Log::result() << "\n╔═════════════════════════════════════════╗\n"
+                  << "║         HOSPITAL ADMISSION TICKET         ║\n"
+                  << "╠═════════════════════════════════════════╣\n"
+                  << "║ Patient ID: " << setw(30) << left << id << "║\n"
+                  << "║ Name: " << setw(34) << left << p.name << "║\n"
+                  << "║ Condition: " << setw(30) << left << p.condition << "║\n"
+                  << "║ Time: " << setw(34) << left << datetime << "║\n"
+                  << "╚═════════════════════════════════════════╝\n";
     return true;
 }
 
 bool PatientAdmission::dischargePatient() {
+    Metrics::Timer timer(Metrics::DISCHARGE_PATIENT);
     // Dequeue: Remove/display front if not empty.
     if (isEmpty()) {
-        cout << "Queue empty." << endl;
+        Log::result() << "Queue empty.\n";
         return false;
     }
-    Patient p = queue[front++];
-    cout << "Discharged: " << p.name << " (ID " << p.id << ", " << p.condition << ")." << endl;
-    currentSize--;
-    savePatientsToFile("data/patients.txt");  // Save after discharge
+    Patient p = dequeue();
+    Log::result() << "Discharged: " << p.name << " (ID " << p.id << ", " << p.condition << ").\n";
+    logOperation("D," + to_string(p.id));  // O(1) journal append
     return true;
 }
 
+int PatientAdmission::admitBatch(const Patient* records, int count) {
+    // Bulk enqueue for shift change: IDs auto-assigned, no tickets, one fsync for the whole batch.
+    Metrics::Timer timer(Metrics::ADMIT_BATCH);   // Whole batch, one sample
+    int admitted = 0;
+    vector<string> entries;
+    entries.reserve(count > 0 ? count : 0);
+    for (int i = 0; i < count; ++i) {
+        Patient p = records[i];
+        if (p.name.empty() || p.condition.empty()) continue;
+        p.id = nextId++;
+        toUppercase(p.name);
+        toUppercase(p.condition);
+        enqueue(p);
+        entries.push_back(admitEntry(p));
+        EventBus::patientAdmitted().publish({p.id, queue[slot(currentSize - 1)]});
+        admitted++;
+    }
+    logBatch(entries);
+    Log::result() << "Admitted " << admitted << " of " << count << " patients.\n";
+    return admitted;
+}
+
+int PatientAdmission::dischargeN(int n) {
+    // Bulk dequeue: earliest n patients (or all remaining), one fsync for the whole batch.
+    Metrics::Timer timer(Metrics::DISCHARGE_BATCH);   // Whole batch, one sample
+    int discharged = 0;
+    vector<string> entries;
+    while (discharged < n && !isEmpty()) {
+        Patient p = dequeue();
+        Log::result() << "Discharged: " << p.name << " (ID " << p.id << ", " << p.condition << ").\n";
+        entries.push_back("D," + to_string(p.id));
+        discharged++;
+    }
+    logBatch(entries);
+    Log::result() << "Discharged " << discharged << " patients.\n";
+    return discharged;
+}
+
 void PatientAdmission::viewPatientQueue() const {
-    // Display: Linear from front (O(n) scan—simple for report). Names already caps.
     if (isEmpty()) {
-        cout << "Queue empty." << endl;
+        cout << "Queue empty.\n";
         return;
     }
-    cout << "\n[ Patient Queue (Earliest First) ]:" << endl;
-    cout << left << setw(5) << "ID" << setw(15) << "Name" << "Condition" << endl;
-    cout << "-----------------------" << string(15, '-') << endl;
-    for (int i = front; i < front + currentSize; ++i) {  // Linear access.
-        int idx = i < MAX_PATIENTS ? i : i % MAX_PATIENTS;  // Safe if overflow.
-        const Patient& p = queue[idx];
-        cout << setw(5) << p.id << setw(15) << p.name << p.condition << endl;
+    PagedView::browse([this](int offset, int limit) { return viewPatientQueue(offset, limit); });
+}
+
+bool PatientAdmission::viewPatientQueue(int offset, int limit) const {
+    // One window of the ring: slot(i) is O(1), so a page is O(limit) however deep it starts.
+    ostream& out = Log::result();
+    if (isEmpty()) {
+        out << "Queue empty.\n";
+        return false;
+    }
+    if (offset >= currentSize) {
+        PagedView::footer(out, offset, 0, currentSize, false);
+        return false;
     }
-    cout << "Total: " << currentSize << "/" << MAX_PATIENTS << endl;
+    int end = min(currentSize, offset + limit);
+    out << "\n[ Patient Queue (Earliest First) ]:\n";
+    out << left << setw(5) << "ID" << setw(15) << "Name" << "Condition\n";
+    out << "-----------------------" << string(15, '-') << "\n";
+    for (int i = offset; i < end; ++i) {  // Linear access (wraps around the ring).
+        PatientRegistry::Entry p = registry.get(queue[slot(i)]);
+        out << setw(5) << p.id << setw(15) << p.name << p.condition << "\n";
+    }
+    PagedView::footer(out, offset, end - offset, currentSize, end < currentSize);
+    return end < currentSize;
 }
 
 bool PatientAdmission::searchPatientById(int searchId) const {
     // Scan queue for ID (O(n); from front for order relevance).
     // Why? Efficient check without full view (e.g., "Is patient X waiting?").
     if (searchId < 1) {
-        cout << "Invalid ID." << endl;
+        Log::error() << "Invalid ID.\n";
         return false;
     }
-    for (int i = front; i < front + currentSize; ++i) {
-        int idx = i < MAX_PATIENTS ? i : i % MAX_PATIENTS;
-        if (queue[idx].id == searchId) {
-            const Patient& p = queue[idx];
-            cout << "Found: " << p.name << " (ID " << p.id << ", " << p.condition << ") at position " << (i - front + 1) << "." << endl;
+    for (int i = 0; i < currentSize; ++i) {
+        PatientRegistry::Entry p = registry.get(queue[slot(i)]);
+        if (p.id == searchId) {
+            Log::result() << "Found: " << p.name << " (ID " << p.id << ", " << p.condition << ") at position " << (i + 1) << ".\n";
             return true;
         }
     }
-    cout << "ID " << searchId << " not in queue." << endl;
+    Log::result() << "ID " << searchId << " not in queue.\n";
     return false;
 }
 
@@ -133,6 +315,8 @@ void PatientAdmission::displayMenu() {
              << "2. Discharge Patient\n"
              << "3. View Patient Queue\n"
              << "4. Search Patient by ID\n"
+             << "5. Admit Batch (Shift Change)\n"
+             << "6. Discharge N Patients\n"
              << "0. Exit Program\n"
              << "-----------------------------------\n"
              << "Enter your choice: ";
@@ -148,17 +332,17 @@ void PatientAdmission::displayMenu() {
 
         switch (choice) {
             case 1:
-                cout << "\n"  << "[ Admitting Patient ]"  << endl;  
+                cout << "\n"  << "[ Admitting Patient ]"  << "\n";  
                 admitPatient();
                 break;
 
             case 2:
-                cout << "\n"  << "[ Discharging Patient ]"  << endl;  
+                cout << "\n"  << "[ Discharging Patient ]"  << "\n";  
                 dischargePatient();
                 break;
 
             case 3:
-                cout << "\n"  << "[ Viewing Patient Queue ]"  << endl;
+                cout << "\n"  << "[ Viewing Patient Queue ]"  << "\n";
                 viewPatientQueue();
                 break;
 
@@ -176,6 +360,46 @@ void PatientAdmission::displayMenu() {
                 break;
             }
 
+            case 5: {
+                int n;
+                cout << "\n"  << "[ Batch Admission ]"  << "\n";
+                cout << "Number of patients: ";
+                cin >> n;
+                if (cin.fail() || n <= 0) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid count.\n";
+                    break;
+                }
+                Patient* batch = new Patient[n];
+                cin >> ws;
+                for (int i = 0; i < n; ++i) {
+                    batch[i].id = 0;
+                    cout << "Patient " << (i + 1) << " Name: ";
+                    getline(cin, batch[i].name);
+                    cout << "Patient " << (i + 1) << " Condition: ";
+                    getline(cin, batch[i].condition);
+                }
+                admitBatch(batch, n);
+                delete[] batch;
+                break;
+            }
+
+            case 6: {
+                int n;
+                cout << "Number of patients to discharge: ";
+                cin >> n;
+                if (!cin.fail() && n > 0) {
+                    cout << "\n"  << "[ Discharging " << n << " Patients ]"  << "\n";
+                    dischargeN(n);
+                } else {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid count.\n";
+                }
+                break;
+            }
+
             case 0:
                 cout << "Exiting program...\n";
                 break;
@@ -188,54 +412,77 @@ void PatientAdmission::displayMenu() {
 }
 
 bool PatientAdmission::loadPatientsFromFile(const string& filename) {
-    ifstream file(filename);
-    if (!file) {
-        cout << "Note: No existing patient file found. Starting fresh." << endl;
+    Metrics::Timer timer(Metrics::LOAD_PATIENTS_CSV);
+    MappedFile file;
+    if (!file.open(filename)) {
+        Log::status() << "Note: No existing patient file found. Starting fresh.\n";
         return false;
     }
 
-    string line;
+    CsvLineReader lines(file.view());
+    string_view line;
     int maxId = 0;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string idStr, name, condition;
-        
-        // Parse CSV format (ID,Name,Condition)
-        if (getline(ss, idStr, ',') && 
-            getline(ss, name, ',') && 
-            getline(ss, condition)) {
-            
-            int id = stoi(idStr);
-            maxId = max(maxId, id);  // Track highest ID
-            
-            if (currentSize < MAX_PATIENTS) {
-                queue[rear].id = id;
-                queue[rear].name = name;
-                queue[rear].condition = condition;
-                rear++;
-                currentSize++;
-            }
+    Patient p;
+    while (lines.nextLine(line)) {
+        // Parse CSV format (ID,Name,Condition) — fields are views into the mapped file.
+        if (PatientLayout::parseCsv(line, p)) {
+            maxId = max(maxId, p.id);  // Track highest ID
+            enqueue(p);
         }
     }
     
     nextId = maxId + 1;  // Set next ID to be one more than highest loaded
-    file.close();
     return true;
 }
 
 bool PatientAdmission::savePatientsToFile(const string& filename) const {
-    ofstream file(filename);
+    Metrics::Timer timer(Metrics::SAVE_PATIENTS_CSV);
+    // Written to a temp file and renamed over the original, so a crash never leaves half a snapshot.
+    string tmp = filename + ".tmp";
+    ofstream file(tmp);
     if (!file) {
-        cout << "Error: Cannot open file for saving." << endl;
+        Log::error() << "Error: Cannot open file for saving.\n";
         return false;
     }
 
-    for (int i = front; i < front + currentSize; ++i) {
-        int idx = i < MAX_PATIENTS ? i : i % MAX_PATIENTS;
-        const Patient& p = queue[idx];
-        file << p.id << "," << p.name << "," << p.condition << endl;
+    Patient p;
+    for (int i = 0; i < currentSize; ++i) {
+        copyOut(i, p);
+        PatientLayout::writeCsv(file, p);
+        file << '\n';
     }
 
     file.close();
+    return file.good() && Journal::replaceFile(tmp, filename);
+}
+
+// ---- Binary snapshot (data/patients.bin): columns from PatientLayout (ints {id}, strings {name, condition}) ----
+bool PatientAdmission::loadPatientsFromBinary(const string& filename) {
+    Metrics::Timer timer(Metrics::LOAD_PATIENTS_BIN);
+    BinarySnapshot::Reader snap;
+    if (!snap.open(filename, BinarySnapshot::PATIENTS, PatientLayout::INT_COLUMNS, PatientLayout::STR_COLUMNS)) {
+        return false;
+    }
+
+    int maxId = 0;
+    Patient p;
+    for (uint32_t r = 0; r < snap.count(); ++r) {
+        PatientLayout::readFrom(snap, r, p);
+        maxId = max(maxId, p.id);
+        enqueue(p);
+    }
+    nextId = maxId + 1;
     return true;
 }
+
+bool PatientAdmission::savePatientsToBinary(const string& filename) const {
+    Metrics::Timer timer(Metrics::SAVE_PATIENTS_BIN);
+    BinarySnapshot::Writer snap(BinarySnapshot::PATIENTS, PatientLayout::INT_COLUMNS, PatientLayout::STR_COLUMNS);
+    snap.reserve(currentSize);
+    Patient p;
+    for (int i = 0; i < currentSize; ++i) {
+        copyOut(i, p);
+        PatientLayout::addTo(snap, p);
+    }
+    return snap.writeTo(filename);
+}
@@ -8,58 +8,99 @@
 // - "View Patient Queue" displays waiting list in exact order (front to rear), simulating hospital waiting room.
 // - Aligns with scenario: "Managing patient queues" during peak ops—efficient for sequential processing.
 // Why ARRAY as underlying structure?
-// - Fixed size (MAX_PATIENTS=100): Predictable memory (O(1) access), suits bounded hospital queue (e.g., limited beds).
-//   No dynamic resizing needed—avoids complexity/overhead of linked lists (pointers, fragmentation).
-// - O(1) enqueue/dequeue amortized (rear++/front++); simple linear traversal for view (O(n), fine for n=100).
+// - Growable chunked array (ChunkedStore): O(1) indexed access, no MAX_PATIENTS cap, and existing
+//   patients never move when the store grows—memory scales with the live queue, not a worst case.
+// - Circular FIFO (ring buffer): front/rear wrap around the slot array, so discharged slots are reused and
+//   O(1) enqueue/dequeue never allocates. Slots are only added when the ring is genuinely full.
+// - The ring holds 32-bit PatientRegistry handles, not the records: name and condition are stored once
+//   (interned) in the shared registry, which Role 3 references too instead of copying them.
+// - Simple linear traversal for view (O(n)).
 // - Vs. Linked List: Array faster (contiguous memory, cache-friendly); linked list better for unbounded but adds nodes (unneeded here).
 // - No STL (<queue>/<vector>): Manual impl per rules—core C++ only.
 // Innovation: Auto-ID (prevents dupes), uppercase names (uniform records), search bonus (quick lookup for efficiency).
+// Integration: every admission (single or batch) is published on EventBus::patientAdmitted(), which Role 3
+//   subscribes to — triage sees the patient at once instead of re-reading patients.txt at startup.
 // Challenges Addressed: "Routine patient flows" (FIFO order) + "user-friendly menu-driven" (sub-menu integration).
 
 #ifndef PATIENT_ADMISSION_HPP
 #define PATIENT_ADMISSION_HPP
 
 #include <string>
+#include <string_view>
+#include <vector>
+#include "ChunkedStore.hpp"
+#include "Journal.hpp"
+#include "PatientRegistry.hpp"
+#include "RecordSchema.hpp"
 
 struct Patient {
     int id;          // Auto-generated unique ID
     std::string name;  // Uppercase for uniformity
     std::string condition;
-    // Why struct? Bundles patient data cleanly for queue ops.
+    // Why struct? Bundles patient data cleanly for file I/O and batch input (queued as a registry handle).
 };
 
+// Storage layout of one patient (patients.txt rows, A journal entries, patients.bin):
+// ID,Name,Condition — the condition is the remainder, so older rows with bare commas still load.
+typedef RecordSchema::Layout<Patient,
+                             RecordSchema::Field<&Patient::id>,
+                             RecordSchema::Field<&Patient::name>,
+                             RecordSchema::Field<&Patient::condition, RecordSchema::REST>> PatientLayout;
+
 class PatientAdmission {
 private:
-    static const int MAX_PATIENTS = 100;  // Why? Predictable size; overflow handled gracefully.
-    Patient queue[MAX_PATIENTS];          // Array storage.
-    int front;                            // Earliest patient index.
-    int rear;                             // Next add index.
+    PatientRegistry& registry;            // Shared records (PatientRegistry::shared()).
+    ChunkedStore<PatientRegistry::Handle> queue; // Ring slots (queue.size() == ring capacity); one reference each.
+    int front;                            // Earliest patient slot.
+    int rear;                             // Next free slot (wraps to 0).
     int currentSize;                      // Count for quick checks.
+
+    // Ring helpers (O(1); growRing only when full):
+    int slot(int pos) const;              // Slot of the pos-th waiting patient.
+    void growRing();                      // Add slots, un-wrapping the queue once.
+    void enqueue(const Patient& p);       // Registers the record
+    Patient dequeue();                    // Copies the record out, then releases it
+    void copyOut(int pos, Patient& out) const; // pos-th waiting patient into a reused buffer
     int nextId;                           // Auto-ID starter (innovation: avoids manual dupes).
+    Journal journal;                      // Append-only log of admits/discharges (data/patients.log).
+
+    // Persistence helpers: one journal entry per operation, CSV rewritten only on compaction.
+    void logOperation(const std::string& entry);
+    void logBatch(const std::vector<std::string>& entries); // Bulk ops: one appendBatch, then compaction check
+    void applyJournalEntry(std::string_view entry);  // Idempotent replay of one entry
+    static std::string admitEntry(const Patient& p); // "A,<PatientLayout row>"
+    void compact();                       // Fold journal into patients.txt
 
 public:
     PatientAdmission();                   // Init empty queue.
-    ~PatientAdmission() {}                // No cleanup needed.
+    ~PatientAdmission();                  // Compacts pending journal entries.
 
     // Core 3 functionalities:
     bool admitPatient();                  // Add to rear (prompts input, auto-ID, uppercase name).
     bool dischargePatient();              // Remove from front, display.
-    void viewPatientQueue() const;        // Show FIFO order.
+    int admit(const std::string& name, const std::string& condition); // Headless admit: no prompt/ticket; ID or -1.
+
+    // Bulk shift-change processing (single save per batch):
+    int admitBatch(const Patient* records, int count); // Enqueue many (IDs auto-assigned); returns admitted.
+    int dischargeN(int n);                // Discharge up to n earliest; returns discharged.
+    void viewPatientQueue() const;        // Show FIFO order, one page at a time (menu).
+    bool viewPatientQueue(int offset, int limit) const; // One page from position offset+1; true if more follow.
 
     // Bonus (innovation):
     bool searchPatientById(int id) const; // O(n) scan: Find/display by ID.
 
     // Helpers:
     bool isEmpty() const { return currentSize == 0; }
-    bool isFull() const { return currentSize == MAX_PATIENTS; }
     int getQueueSize() const { return currentSize; }
 
     // Menu for demo/integration:
-    void displayMenu();                   // Sub-menu loop (now with option 4: search).
+    void displayMenu();                   // Sub-menu loop (search, batch admit/discharge).
 
     // File Operations:
     bool loadPatientsFromFile(const std::string& filename);  // Load patient data from file
     bool savePatientsToFile(const std::string& filename) const;  // Save patient data to file
+    bool loadPatientsFromBinary(const std::string& filename);      // Fast path: data/patients.bin
+    bool savePatientsToBinary(const std::string& filename) const;  // Written on compaction
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+// PatientRegistry.cpp
+// Implementation of the shared patient registry (see PatientRegistry.hpp).
+// Complexity: add / share / retain / release / get O(1) average (hash lookups, free-list slots).
+
+#include "PatientRegistry.hpp"
+#include <mutex>
+#include "Metrics.hpp"
+
+using namespace std;
+
+PatientRegistry::PatientRegistry() : liveRecords_(0), liveStrings_(0) {}
+
+PatientRegistry& PatientRegistry::shared() {
+    static PatientRegistry registry;   // Constructed on first use (thread-safe)
+    return registry;
+}
+
+PatientRegistry::Handle PatientRegistry::add(int id, string_view name, string_view condition) {
+    unique_lock<shared_mutex> lock(mutex_);
+    Handle h = newRecord(id, name, condition);
+    byId_[id] = h;   // The latest admission under an ID wins (e.g. a reloaded queue)
+    publishGauges();
+    return h;
+}
+
+PatientRegistry::Handle PatientRegistry::share(int id, string_view name, string_view condition) {
+    unique_lock<shared_mutex> lock(mutex_);
+    auto it = byId_.find(id);
+    if (it != byId_.end()) {
+        Record& r = records_[static_cast<int>(it->second)];
+        if (strings_[static_cast<int>(r.name)].text == name &&
+            strings_[static_cast<int>(r.condition)].text == condition) {
+            ++r.refs;
+            return it->second;
+        }
+    }
+    Handle h = newRecord(id, name, condition);
+    publishGauges();
+    return h;
+}
+
+PatientRegistry::Handle PatientRegistry::find(int id) const {
+    shared_lock<shared_mutex> lock(mutex_);
+    auto it = byId_.find(id);
+    return it == byId_.end() ? NONE : it->second;
+}
+
+void PatientRegistry::retain(Handle h) {
+    if (h == NONE) return;
+    unique_lock<shared_mutex> lock(mutex_);
+    ++records_[static_cast<int>(h)].refs;
+}
+
+void PatientRegistry::release(Handle h) {
+    if (h == NONE) return;
+    unique_lock<shared_mutex> lock(mutex_);
+    Record& r = records_[static_cast<int>(h)];
+    if (r.refs == 0 || --r.refs > 0) return;
+    auto it = byId_.find(r.id);
+    if (it != byId_.end() && it->second == h) byId_.erase(it);
+    dropText(r.name);
+    dropText(r.condition);
+    r = Record();
+    freeRecords_.push_back(h);
+    --liveRecords_;
+    publishGauges();
+}
+
+PatientRegistry::Entry PatientRegistry::get(Handle h) const {
+    shared_lock<shared_mutex> lock(mutex_);
+    const Record& r = records_[static_cast<int>(h)];
+    return Entry{ r.id, strings_[static_cast<int>(r.name)].text, strings_[static_cast<int>(r.condition)].text };
+}
+
+int PatientRegistry::records() const {
+    shared_lock<shared_mutex> lock(mutex_);
+    return liveRecords_;
+}
+
+int PatientRegistry::strings() const {
+    shared_lock<shared_mutex> lock(mutex_);
+    return liveStrings_;
+}
+
+// ---- Under the exclusive lock ----
+
+PatientRegistry::Handle PatientRegistry::newRecord(int id, string_view name, string_view condition) {
+    Record r;
+    r.id = id;
+    r.name = intern(name);
+    r.condition = intern(condition);
+    r.refs = 1;
+    Handle h;
+    if (!freeRecords_.empty()) {
+        h = freeRecords_.back();
+        freeRecords_.pop_back();
+        records_[static_cast<int>(h)] = r;
+    } else {
+        h = static_cast<Handle>(records_.size());
+        records_.push_back(r);
+    }
+    ++liveRecords_;
+    return h;
+}
+
+uint32_t PatientRegistry::intern(string_view text) {
+    auto it = stringIds_.find(text);
+    if (it != stringIds_.end()) {
+        ++strings_[static_cast<int>(it->second)].refs;
+        return it->second;
+    }
+    uint32_t slot;
+    if (!freeStrings_.empty()) {
+        slot = freeStrings_.back();
+        freeStrings_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(strings_.size());
+        strings_.push_back(Text());
+    }
+    Text& t = strings_[static_cast<int>(slot)];
+    t.text.assign(text.data(), text.size());   // In place: the key below views the stored copy
+    t.refs = 1;
+    stringIds_.emplace(string_view(t.text), slot);
+    ++liveStrings_;
+    return slot;
+}
+
+void PatientRegistry::dropText(uint32_t slot) {
+    Text& t = strings_[static_cast<int>(slot)];
+    if (--t.refs > 0) return;
+    stringIds_.erase(string_view(t.text));
+    string().swap(t.text);   // Release the payload; the slot is reused
+    freeStrings_.push_back(slot);
+    --liveStrings_;
+}
+
+void PatientRegistry::publishGauges() const {
+    Metrics::setGauge(Metrics::REGISTRY_RECORDS, liveRecords_);
+    Metrics::setGauge(Metrics::REGISTRY_STRINGS, liveStrings_);
+}
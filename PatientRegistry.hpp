@@ -0,0 +1,97 @@
+// PatientRegistry.hpp
+// Shared in-memory patient records for Role 1 (admission queue) and Role 3 (triage heap).
+// Data Structure Choice: REFERENCE-COUNTED RECORD TABLE + STRING INTERN POOL + ID HASH INDEX
+// Why?
+// - Every admitted patient used to be stored twice: the admission queue held the name and
+//   condition strings, and the Emergency Department copied both again into its own case (the
+//   admission event itself carried a third, temporary copy). Here each record is stored once and
+//   the modules hold a 32-bit Handle to it: the queue ring is an array of handles and a triage
+//   heap slot is a few integers, so the hot structures are several times denser.
+// - Strings are interned: each distinct text (a name, "FEVER", "Heart Attack") is kept once, with a
+//   reference count, whatever the number of records using it. A record is 16 bytes.
+// - Records are reference counted: the queue and the triage heap each hold one reference, so a
+//   patient discharged from the queue but still waiting for triage keeps its record, and the record
+//   (and any string nobody else uses) is freed when the last holder releases it. Freed slots are
+//   reused; storage is ChunkedStore, so records and strings never move once placed.
+// - ID index: find(id) is an O(1) average hash lookup of the record the admission desk registered
+//   for that patient ID, so any module can reach the admitted patient without scanning the queue,
+//   and share() lets a module reuse that record when its own copy (e.g. a triage case imported from
+//   patients.txt) has the same text.
+// - Threads: service-mode terminals use the queue and the heap under different module locks, so the
+//   registry has its own reader/writer lock (short critical sections, no I/O under it). A holder may
+//   keep the string_views from get() for as long as it holds its reference: the text cannot be freed
+//   or moved under it.
+// Usage: PatientRegistry::shared() is the process-wide instance (like EventBus::patientAdmitted()).
+
+#ifndef PATIENT_REGISTRY_HPP
+#define PATIENT_REGISTRY_HPP
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ChunkedStore.hpp"
+
+class PatientRegistry {
+public:
+    typedef uint32_t Handle;
+    static constexpr Handle NONE = 0xFFFFFFFFu;
+
+    struct Entry {
+        int id;
+        std::string_view name;        // Valid while the caller holds a reference to the record
+        std::string_view condition;
+    };
+
+    PatientRegistry();
+    PatientRegistry(const PatientRegistry&) = delete;
+    PatientRegistry& operator=(const PatientRegistry&) = delete;
+
+    static PatientRegistry& shared();   // Process-wide registry
+
+    // New record with one reference; it becomes find(id)'s answer (the admission record). O(1) average.
+    Handle add(int id, std::string_view name, std::string_view condition);
+    // The record find(id) returns if its text matches (one more reference), else a new record that
+    // is not indexed by ID. For copies held by other modules. O(1) average.
+    Handle share(int id, std::string_view name, std::string_view condition);
+    Handle find(int id) const;          // Admission record for id, or NONE. O(1) average, no reference taken
+
+    void retain(Handle h);              // One more reference (e.g. to a handle received in an event)
+    void release(Handle h);             // Frees the record (and unused strings) at zero. NONE is ignored
+
+    Entry get(Handle h) const;
+
+    int records() const;                // Live records
+    int strings() const;                // Distinct interned strings
+
+private:
+    struct Record {
+        int id = 0;
+        uint32_t name = 0;           // Interned string slots
+        uint32_t condition = 0;
+        uint32_t refs = 0;           // 0 = free slot
+    };
+    struct Text {
+        std::string text;
+        uint32_t refs = 0;
+    };
+
+    Handle newRecord(int id, std::string_view name, std::string_view condition);
+    uint32_t intern(std::string_view text);
+    void dropText(uint32_t slot);
+    void publishGauges() const;
+
+    mutable std::shared_mutex mutex_;
+    ChunkedStore<Record> records_;
+    std::vector<Handle> freeRecords_;
+    ChunkedStore<Text> strings_;
+    std::vector<uint32_t> freeStrings_;
+    std::unordered_map<std::string_view, uint32_t> stringIds_;   // Views into strings_ (stable)
+    std::unordered_map<int, Handle> byId_;
+    int liveRecords_;
+    int liveStrings_;
+};
+
+#endif // PATIENT_REGISTRY_HPP
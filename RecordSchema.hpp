@@ -0,0 +1,258 @@
+// RecordSchema.hpp
+// Declarative storage layouts for the four record types (Patient, EmergencyCase, MedicalSupply::Supply,
+// Ambulance::Record): one list of fields drives the CSV parser, the CSV writer and both directions of
+// the binary snapshot.
+// Data Structure Choice: VARIADIC TEMPLATE OVER POINTER-TO-MEMBER FIELDS (resolved at compile time)
+// Why?
+// - Every module used to spell its column order three or four times (tokenizer chain in the loader,
+//   journal replay, << chain in the save, int/string arrays for the .bin), and the copies drifted:
+//   the ambulance loader guessed between an old and a new format at run time.
+// - Here a layout is a type, e.g.
+//     typedef RecordSchema::Layout<Patient, RecordSchema::Field<&Patient::id>,
+//                                  RecordSchema::Field<&Patient::name>,
+//                                  RecordSchema::Field<&Patient::condition, RecordSchema::REST>> PatientLayout;
+//   and parseCsv / writeCsv / appendCsv / addTo / readFrom are fold expressions over that list: the
+//   compiler emits the straight-line sequence of field reads and writes, with binary column indexes
+//   as constants. No format flags, no per-field switch, no virtual calls.
+// - Column kinds come from the member type: int and bool take one int column, long long two (high,
+//   low), std::string one string column. The column counts are constexpr (INT_COLUMNS / STR_COLUMNS)
+//   and match the layouts the .bin files already use, so existing snapshots still load.
+// - Presence rules replace the old format checks: REQUIRED fields must parse; OPTIONAL fields may be
+//   missing (older, shorter rows) or blank and then take the member's value-initialised default;
+//   a REST field (text, last) must be present and takes the remainder of the line, so free text
+//   written by older builds with bare commas still loads. REQUIRED may not follow OPTIONAL and REST must be last (checked
+//   by static_assert).
+// - Quoting: text containing the delimiter, a quote or edge whitespace is written as "..." with ""
+//   for a quote, and read back exactly (CsvTokenizer::nextQuoted); plain text is written bare, so
+//   files without such characters are byte-for-byte as before.
+
+#ifndef RECORD_SCHEMA_HPP
+#define RECORD_SCHEMA_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "BinarySnapshot.hpp"
+#include "CsvTokenizer.hpp"
+
+namespace RecordSchema {
+
+enum Presence { REQUIRED, OPTIONAL, REST };
+
+// ---- Output sinks: a std::string (journal entries) or a stream (snapshot files) ----
+inline void put(std::string& out, std::string_view s) { out.append(s.data(), s.size()); }
+inline void put(std::ostream& out, std::string_view s) { out.write(s.data(), static_cast<std::streamsize>(s.size())); }
+
+template <typename Out>
+void putText(Out& out, std::string_view text) {
+    if (!csvNeedsQuotes(text)) {
+        put(out, text);
+        return;
+    }
+    put(out, "\"");
+    size_t from = 0;
+    for (size_t q = text.find('"'); q != std::string_view::npos; q = text.find('"', q + 1)) {
+        put(out, text.substr(from, q + 1 - from));   // Up to and including the quote...
+        put(out, "\"");                              // ...which is doubled
+        from = q + 1;
+    }
+    put(out, text.substr(from));
+    put(out, "\"");
+}
+
+template <typename Out, typename Int>
+void putInt(Out& out, Int value) {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof buf, value);
+    put(out, std::string_view(buf, static_cast<size_t>(res.ptr - buf)));
+}
+
+// ---- Column kinds, one per member type ----
+template <typename T> struct Column;
+
+template <> struct Column<int> {
+    static constexpr uint32_t INTS = 1, STRS = 0;
+    static bool parse(std::string_view raw, int& v) { return parseIntField(raw, v); }
+    template <typename Out> static void write(Out& out, int v) { putInt(out, v); }
+    static void store(int v, int32_t* ints, std::string_view*) { ints[0] = v; }
+    static void load(const BinarySnapshot::Reader& s, uint32_t row, uint32_t i, uint32_t, int& v) {
+        v = s.intAt(row, i);
+    }
+};
+
+template <> struct Column<bool> {
+    static constexpr uint32_t INTS = 1, STRS = 0;
+    static bool parse(std::string_view raw, bool& v) {
+        int n;
+        if (!parseIntField(raw, n)) return false;
+        v = n != 0;
+        return true;
+    }
+    template <typename Out> static void write(Out& out, bool v) { put(out, v ? "1" : "0"); }
+    static void store(bool v, int32_t* ints, std::string_view*) { ints[0] = v ? 1 : 0; }
+    static void load(const BinarySnapshot::Reader& s, uint32_t row, uint32_t i, uint32_t, bool& v) {
+        v = s.intAt(row, i) != 0;
+    }
+};
+
+template <> struct Column<long long> {   // Two int columns: high 32 bits, then low 32 bits
+    static constexpr uint32_t INTS = 2, STRS = 0;
+    static bool parse(std::string_view raw, long long& v) { return parseIntField(raw, v); }
+    template <typename Out> static void write(Out& out, long long v) { putInt(out, v); }
+    static void store(long long v, int32_t* ints, std::string_view*) {
+        ints[0] = static_cast<int32_t>(v >> 32);
+        ints[1] = static_cast<int32_t>(static_cast<uint32_t>(v));
+    }
+    static void load(const BinarySnapshot::Reader& s, uint32_t row, uint32_t i, uint32_t, long long& v) {
+        v = (static_cast<long long>(s.intAt(row, i)) << 32) | static_cast<uint32_t>(s.intAt(row, i + 1));
+    }
+};
+
+template <> struct Column<std::string> {
+    static constexpr uint32_t INTS = 0, STRS = 1;
+    static bool parse(std::string_view raw, std::string& v) {
+        assignCsvText(raw, v);
+        return true;
+    }
+    template <typename Out> static void write(Out& out, const std::string& v) { putText(out, v); }
+    static void store(const std::string& v, int32_t*, std::string_view* strs) { strs[0] = v; }
+    static void load(const BinarySnapshot::Reader& s, uint32_t row, uint32_t, uint32_t i, std::string& v) {
+        std::string_view text = s.strAt(row, i);
+        v.assign(text.data(), text.size());
+    }
+};
+
+// ---- One field: a data member plus its presence rule ----
+template <typename M> struct MemberOf;
+template <typename R, typename T> struct MemberOf<T R::*> {
+    typedef R Record;
+    typedef T Value;
+};
+
+template <auto Member, Presence P = REQUIRED>
+struct Field {
+    typedef typename MemberOf<decltype(Member)>::Record Record;
+    typedef typename MemberOf<decltype(Member)>::Value Value;
+    typedef RecordSchema::Column<Value> Column;
+    static constexpr auto member = Member;
+    static constexpr Presence presence = P;
+    static_assert(P != REST || Column::STRS == 1, "a REST field must be text");
+
+    static bool parse(CsvTokenizer& tok, Record& r) {
+        if constexpr (P == REST) {
+            return !tok.done() && Column::parse(tok.restQuoted(), r.*Member);   // Column must exist
+        }
+        std::string_view raw;
+        if (!tok.nextQuoted(raw)) {
+            if (P == REQUIRED) return false;
+            r.*Member = Value();   // Missing trailing column (shorter, older row)
+            return true;
+        }
+        if (Column::parse(raw, r.*Member)) return true;
+        if (P == REQUIRED) return false;
+        r.*Member = Value();       // Blank or malformed optional value
+        return true;
+    }
+};
+
+// ---- The layout: parse / write a CSV row, store / load a binary row ----
+template <typename R, typename... Fields>
+class Layout {
+public:
+    static constexpr uint32_t INT_COLUMNS = (0 + ... + Fields::Column::INTS);
+    static constexpr uint32_t STR_COLUMNS = (0 + ... + Fields::Column::STRS);
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+
+    // One CSV row (no trailing newline). False if a required field is missing or malformed;
+    // r may then be partly assigned.
+    static bool parseCsv(std::string_view line, R& r) {
+        CsvTokenizer tok(line);
+        return (Fields::parse(tok, r) && ...);
+    }
+
+    template <typename Out>
+    static void writeCsv(Out& out, const R& r) {
+        writeFields(out, r, std::index_sequence_for<Fields...>());
+    }
+
+    static void appendCsv(std::string& out, const R& r) { writeCsv(out, r); }
+
+    static std::string csvLine(const R& r) {
+        std::string out;
+        writeCsv(out, r);
+        return out;
+    }
+
+    static void addTo(BinarySnapshot::Writer& snap, const R& r) {
+        int32_t ints[INT_COLUMNS ? INT_COLUMNS : 1];
+        std::string_view strs[STR_COLUMNS ? STR_COLUMNS : 1];
+        storeFields(r, ints, strs, std::index_sequence_for<Fields...>());
+        snap.addRecord(ints, strs);
+    }
+
+    static void readFrom(const BinarySnapshot::Reader& snap, uint32_t row, R& r) {
+        loadFields(snap, row, r, std::index_sequence_for<Fields...>());
+    }
+
+private:
+    template <size_t I> using Nth = typename std::tuple_element<I, std::tuple<Fields...>>::type;
+
+    static constexpr Presence presenceAt(size_t i) {
+        const Presence all[] = { Fields::presence... };
+        return all[i];
+    }
+    static constexpr uint32_t intOffset(size_t i) {
+        const uint32_t cols[] = { Fields::Column::INTS... };
+        uint32_t n = 0;
+        for (size_t k = 0; k < i; ++k) n += cols[k];
+        return n;
+    }
+    static constexpr uint32_t strOffset(size_t i) {
+        const uint32_t cols[] = { Fields::Column::STRS... };
+        uint32_t n = 0;
+        for (size_t k = 0; k < i; ++k) n += cols[k];
+        return n;
+    }
+    static constexpr bool wellFormed() {
+        bool optionalSeen = false;
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {
+            if (presenceAt(i) == REST && i + 1 != FIELD_COUNT) return false;
+            if (presenceAt(i) == REQUIRED && optionalSeen) return false;
+            if (presenceAt(i) == OPTIONAL) optionalSeen = true;
+        }
+        return true;
+    }
+    static_assert(FIELD_COUNT > 0, "a layout needs at least one field");
+    static_assert(wellFormed(), "REQUIRED fields may not follow OPTIONAL ones, and REST must be last");
+    static_assert((std::is_same<typename Fields::Record, R>::value && ...), "field of another record type");
+
+    template <typename Out, size_t... I>
+    static void writeFields(Out& out, const R& r, std::index_sequence<I...>) {
+        (writeField<I>(out, r), ...);
+    }
+
+    template <size_t I, typename Out>
+    static void writeField(Out& out, const R& r) {
+        if constexpr (I > 0) put(out, ",");
+        Nth<I>::Column::write(out, r.*Nth<I>::member);
+    }
+
+    template <size_t... I>
+    static void storeFields(const R& r, int32_t* ints, std::string_view* strs, std::index_sequence<I...>) {
+        (Nth<I>::Column::store(r.*Nth<I>::member, ints + intOffset(I), strs + strOffset(I)), ...);
+    }
+
+    template <size_t... I>
+    static void loadFields(const BinarySnapshot::Reader& snap, uint32_t row, R& r, std::index_sequence<I...>) {
+        (Nth<I>::Column::load(snap, row, intOffset(I), strOffset(I), r.*Nth<I>::member), ...);
+    }
+};
+
+} // namespace RecordSchema
+
+#endif // RECORD_SCHEMA_HPP
@@ -0,0 +1,135 @@
+// ServiceCore.cpp
+// Implementation of the concurrent service mode (see ServiceCore.hpp).
+// Complexity: each command costs its module operation plus one lock acquisition; terminals only
+// contend when they touch the same module and at least one of them writes.
+
+#include "ServiceCore.hpp"
+#include "EventBus.hpp"
+#include "Log.hpp"
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+using namespace std;
+
+static const char* const MODULE_NAMES[] = { "patients", "supplies", "emergency", "ambulances" };
+
+ServiceCore::ServiceCore(HospitalModules& modules, unsigned threads)
+    : modules_(modules), failed_(0), drainScheduled_(false), pool_(threads) {
+    for (int i = 0; i < MODULES; ++i) handled_[i] = 0;
+    // Subscribed after the Emergency Department, so the admission is already queued when this runs.
+    admissionToken_ = EventBus::patientAdmitted().subscribe([this](const EventBus::PatientAdmitted&) {
+        scheduleDrain();
+    });
+}
+
+ServiceCore::~ServiceCore() {
+    EventBus::patientAdmitted().unsubscribe(admissionToken_);
+}
+
+bool ServiceCore::execute(const Command& cmd, string& error) {
+    CommandAccess access;
+    CommandTarget target = commandTarget(cmd.name, access);
+    // No module: lock-free commands (metrics), or an unknown name that runCommand reports.
+    if (target == CommandTarget::UNKNOWN) return runCommand(cmd, modules_, error);
+
+    int m = static_cast<int>(target);
+    handled_[m].fetch_add(1, memory_order_relaxed);
+    if (access == CommandAccess::INTAKE) {
+        bool ok = runCommand(cmd, modules_, error);   // Lock-free push; never waits for triage
+        if (ok) scheduleDrain();
+        return ok;
+    }
+    if (access == CommandAccess::DISPATCH) {   // Both modules, always in index order: no deadlock
+        unique_lock<shared_mutex> first(locks_[static_cast<int>(CommandTarget::EMERGENCY)]);
+        unique_lock<shared_mutex> second(locks_[static_cast<int>(CommandTarget::AMBULANCES)]);
+        return runCommand(cmd, modules_, error);
+    }
+    if (access == CommandAccess::READ) {
+        shared_lock<shared_mutex> lock(locks_[m]);
+        return runCommand(cmd, modules_, error);
+    }
+    unique_lock<shared_mutex> lock(locks_[m]);
+    return runCommand(cmd, modules_, error);
+}
+
+void ServiceCore::scheduleDrain() {
+    // At most one drain queued at a time; it clears the flag before draining, so a case submitted
+    // while it runs schedules the next one and nothing is left behind.
+    if (drainScheduled_.exchange(true, memory_order_acq_rel)) return;
+    pool_.submit([this] {
+        drainScheduled_.store(false, memory_order_release);
+        unique_lock<shared_mutex> lock(locks_[static_cast<int>(CommandTarget::EMERGENCY)]);
+        modules_.em.drainIntake();
+    });
+}
+
+void ServiceCore::runNext(Terminal* t, int number) {
+    const Command& cmd = t->commands[t->next++];
+    string error;
+
+    Log::bind(&t->output);
+    if (execute(cmd, error)) {
+        Log::result() << "[terminal " << number << "] line " << cmd.line << ": " << cmd.name << " ok\n";
+    } else {
+        t->failed++;
+        failed_.fetch_add(1, memory_order_relaxed);
+        ostream& out = Log::error();
+        out << "[terminal " << number << "] line " << cmd.line << ": " << cmd.name << " FAILED";
+        if (!error.empty()) out << " (" << error << ")";
+        out << "\n";
+    }
+    Log::bind(nullptr);
+
+    // Keep this terminal's order: its next command is queued only after this one completed.
+    if (t->next < t->commands.size()) pool_.submit([this, t, number] { runNext(t, number); });
+}
+
+int ServiceCore::serve(vector<Terminal>& terminals) {
+    failed_ = 0;
+    for (size_t i = 0; i < terminals.size(); ++i) {
+        Terminal* t = &terminals[i];
+        int number = static_cast<int>(i) + 1;
+        if (!t->commands.empty()) pool_.submit([this, t, number] { runNext(t, number); });
+    }
+    pool_.wait();
+    return failed_.load();
+}
+
+int runService(const vector<string>& sources, unsigned threads) {
+    vector<ServiceCore::Terminal> terminals(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        ifstream file(sources[i]);
+        if (!file) {
+            cerr << "Cannot open terminal script '" << sources[i] << "'.\n";
+            return 2;
+        }
+        terminals[i].source = sources[i];
+        string line;
+        Command cmd;
+        int lineNo = 0;
+        while (getline(file, line)) {
+            if (parseCommandLine(line, ++lineNo, cmd)) terminals[i].commands.push_back(cmd);
+        }
+    }
+
+    int failed;
+    {
+        HospitalModules modules;
+        ServiceCore core(modules, threads);
+        failed = core.serve(terminals);
+
+        for (size_t i = 0; i < terminals.size(); ++i) {
+            cout << "\n=== Terminal " << (i + 1) << " (" << terminals[i].source << ") ===\n"
+                 << terminals[i].output.str();
+        }
+        ostream& out = Log::error();
+        out << "\n[serve] " << terminals.size() << " terminals on " << core.threads() << " threads;";
+        for (int m = 0; m < 4; ++m) {
+            out << " " << MODULE_NAMES[m] << " " << core.handled(static_cast<CommandTarget>(m));
+        }
+        out << "; " << failed << " failed.\n";
+    }   // Workers joined, then final compaction
+    cout << flush;
+    return failed ? 1 : 0;
+}
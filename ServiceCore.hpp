@@ -0,0 +1,75 @@
+// ServiceCore.hpp
+// Concurrent service mode: several front-desk terminals drive the four roles at the same time.
+// Usage: ./main --serve desk1.txt desk2.txt ... [--threads N]   (one command script per terminal,
+//        same command language as --batch, see BatchMode.hpp)
+// Concurrency model:
+// - ONE READER/WRITER LOCK PER MODULE (std::shared_mutex). A command locks only the module it
+//   touches, so an admission, a triage update, a supply use and a shift change run in parallel on
+//   different cores; two writes to the same module are serialised (the modules and their journals
+//   are single-writer structures).
+// - Read-only commands (find-patient, pending, stock, on-duty) take the lock shared: any number of
+//   readers proceed together and only wait for an in-progress write to the same module.
+// - A fixed ThreadPool runs the handlers. Each terminal is a session whose commands execute in
+//   order; after one finishes the worker queues the session's next command, so N terminals share
+//   the pool fairly and the throughput scales with cores instead of one cin loop.
+// - Output: each handler binds its terminal's buffer as the thread's Log sink, so nothing
+//   interleaves; the buffers are printed per terminal when the run completes.
+// - Emergency intake (submit-emergency) takes no lock at all: the case goes into the department's
+//   lock-free MPSC queue and one drain task per burst (the single triage consumer) moves the queued
+//   cases into the heap under the exclusive lock. Producers never wait for the heap. Admissions
+//   reach the same queue over the event bus, and schedule the same drain.
+// - dispatch needs the Emergency Department and the fleet at once: it takes both exclusive locks in
+//   module-index order (the only multi-lock command, so no lock-order cycle is possible).
+// - Per-module request counters are atomics (no lock needed to report them).
+
+#ifndef SERVICE_CORE_HPP
+#define SERVICE_CORE_HPP
+
+#include <atomic>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BatchMode.hpp"
+#include "ThreadPool.hpp"
+
+class ServiceCore {
+public:
+    struct Terminal {
+        std::string source;              // Script path (for the report)
+        std::vector<Command> commands;
+        std::ostringstream output;       // Everything this terminal's commands printed
+        size_t next = 0;                 // Next command to run (touched by one worker at a time)
+        int failed = 0;
+    };
+
+    explicit ServiceCore(HospitalModules& modules, unsigned threads = 0);
+    ~ServiceCore();
+
+    // Run one command under its module's lock; output goes to the calling thread's Log sink.
+    bool execute(const Command& cmd, std::string& error);
+
+    // Run every terminal's commands concurrently (each in its own order). Returns total failures.
+    int serve(std::vector<Terminal>& terminals);
+
+    long handled(CommandTarget target) const { return handled_[static_cast<int>(target)].load(); }
+    unsigned threads() const { return pool_.size(); }
+
+private:
+    void runNext(Terminal* t, int number);
+    void scheduleDrain();                     // Queue the triage consumer unless one is pending
+
+    static const int MODULES = 4;
+    HospitalModules& modules_;
+    std::shared_mutex locks_[MODULES];        // Indexed by CommandTarget
+    std::atomic<long> handled_[MODULES];
+    std::atomic<int> failed_;
+    std::atomic<bool> drainScheduled_;
+    int admissionToken_;                      // EventBus subscription: admissions trigger a drain
+    ThreadPool pool_;                         // Last: workers stop before the locks go away
+};
+
+// Load each script, run them as concurrent terminals, print each terminal's output. Exit code.
+int runService(const std::vector<std::string>& sources, unsigned threads);
+
+#endif // SERVICE_CORE_HPP
@@ -0,0 +1,118 @@
+// ShiftIndex.cpp
+// Implementation of the centered interval tree over shifts (see ShiftIndex.hpp).
+// Complexity: set/erase O(1); rebuild O(n log n) once per batch of changes; query O(log n + k).
+
+#include "ShiftIndex.hpp"
+#include <algorithm>
+
+using namespace std;
+
+void ShiftIndex::set(int id, int shiftStart, int shiftEnd) {
+    shifts_[id] = make_pair(shiftStart, shiftEnd);
+    dirty_ = true;
+}
+
+void ShiftIndex::erase(int id) {
+    if (shifts_.erase(id)) dirty_ = true;
+}
+
+void ShiftIndex::clear() {
+    shifts_.clear();
+    nodes_.clear();
+    root_ = -1;
+    dirty_ = false;
+}
+
+void ShiftIndex::ensureBuilt() const {
+    if (dirty_.load(std::memory_order_acquire)) {
+        lock_guard<mutex> guard(rebuildMutex_);
+        if (dirty_.load(std::memory_order_relaxed)) rebuild();   // Another reader may have won the race
+    }
+}
+
+void ShiftIndex::onDutyAt(int minute, vector<int>& out) const {
+    Cursor cursor(*this, minute);
+    int id;
+    while (cursor.next(id)) out.push_back(id);
+}
+
+ShiftIndex::Cursor::Cursor(const ShiftIndex& index, int minute)
+    : index_(index), minute_(minute), node_(-1), pos_(0) {
+    index_.ensureBuilt();
+    node_ = index_.root_;
+}
+
+bool ShiftIndex::Cursor::next(int& id) {
+    while (node_ != -1) {
+        const TreeNode& node = index_.nodes_[node_];
+        if (minute_ < node.center) {
+            // Every interval here ends after center > minute: it contains minute iff it has started.
+            if (pos_ < node.byStart.size() && node.byStart[pos_].start <= minute_) {
+                id = node.byStart[pos_++].id;
+                return true;
+            }
+            node_ = node.left;
+        } else {
+            // Every interval here starts at or before center <= minute: contains minute iff not yet ended.
+            if (pos_ < node.byEnd.size() && node.byEnd[pos_].end > minute_) {
+                id = node.byEnd[pos_++].id;
+                return true;
+            }
+            node_ = node.right;
+        }
+        pos_ = 0;
+    }
+    return false;
+}
+
+void ShiftIndex::rebuild() const {
+    vector<Interval> items;
+    items.reserve(shifts_.size() + 8);
+    for (const auto& kv : shifts_) {
+        int start = kv.second.first, end = kv.second.second;
+        if (start == 0 && end == 0) continue;           // Not assigned
+        if (start < end) {
+            items.push_back({start, end, kv.first});
+        } else {                                        // Overnight: split at midnight
+            items.push_back({start, MINUTES_PER_DAY, kv.first});
+            if (end > 0) items.push_back({0, end, kv.first});
+        }
+    }
+    nodes_.clear();
+    root_ = build(items);
+    dirty_.store(false, std::memory_order_release);   // Publishes nodes_/root_ to readers that skip the mutex
+}
+
+int ShiftIndex::build(vector<Interval>& items) const {
+    if (items.empty()) return -1;
+
+    // Center on the median start: the interval that starts there contains it, so every node
+    // holds at least one interval and both halves shrink.
+    vector<int> starts;
+    starts.reserve(items.size());
+    for (const Interval& iv : items) starts.push_back(iv.start);
+    nth_element(starts.begin(), starts.begin() + starts.size() / 2, starts.end());
+    int center = starts[starts.size() / 2];
+
+    vector<Interval> leftItems, rightItems, here;
+    for (const Interval& iv : items) {
+        if (iv.end <= center) leftItems.push_back(iv);
+        else if (iv.start > center) rightItems.push_back(iv);
+        else here.push_back(iv);
+    }
+
+    int index = static_cast<int>(nodes_.size());
+    nodes_.push_back(TreeNode());
+    nodes_[index].center = center;
+    nodes_[index].byEnd = here;
+    sort(here.begin(), here.end(), [](const Interval& a, const Interval& b) { return a.start < b.start; });
+    sort(nodes_[index].byEnd.begin(), nodes_[index].byEnd.end(),
+         [](const Interval& a, const Interval& b) { return a.end > b.end; });
+    nodes_[index].byStart = std::move(here);
+
+    int left = build(leftItems);     // nodes_ may reallocate: assign children via index
+    int right = build(rightItems);
+    nodes_[index].left = left;
+    nodes_[index].right = right;
+    return index;
+}
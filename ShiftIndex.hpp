@@ -0,0 +1,78 @@
+// ShiftIndex.hpp
+// Interval index over ambulance shifts for Role 4 ("who is on duty at minute T?").
+// Data Structure Choice: CENTERED INTERVAL TREE (rebuilt lazily after changes)
+// Why?
+// - A stabbing query visits one root-to-leaf path (O(log n)) and, at each node, scans only
+//   intervals that really contain T (sorted by start / by end), so a query is O(log n + k).
+// - Shifts change rarely (assign/register/remove) while the dispatch side asks on every call,
+//   so insert/erase are O(1) on the id -> shift table and just mark the tree dirty; the next
+//   query rebuilds it once in O(n log n).
+// - Overnight shifts (start > end, e.g. 22:00-06:00) are split into [start, 1440) and [0, end),
+//   so the tree only stores non-wrapping half-open intervals. 0-0 means "not assigned".
+// Threads: queries are const and may run concurrently (service mode readers hold a shared lock);
+//   the lazy rebuild is guarded so only the first reader after a change rebuilds the tree.
+//   set/erase/clear need exclusive access, like every other mutation of the roster.
+
+#ifndef SHIFT_INDEX_HPP
+#define SHIFT_INDEX_HPP
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class ShiftIndex {
+public:
+    static const int MINUTES_PER_DAY = 1440;
+
+    ShiftIndex() : root_(-1), dirty_(false) {}
+
+    void set(int id, int shiftStart, int shiftEnd);   // Insert or replace (O(1), marks dirty)
+    void erase(int id);                               // O(1), marks dirty
+    void clear();
+
+    // IDs of units whose shift contains minute (0-1439). O(log n + k) once built.
+    void onDutyAt(int minute, std::vector<int>& out) const;
+
+    // Same query, one ID at a time (no output vector): walks the root-to-leaf path lazily, so a
+    // caller that stops after p IDs pays O(log n + p). Tree order, not ID order. Valid until the
+    // next set/erase/clear.
+    class Cursor {
+    public:
+        Cursor(const ShiftIndex& index, int minute);   // Rebuilds the tree first if it is dirty
+        bool next(int& id);
+    private:
+        const ShiftIndex& index_;
+        int minute_;
+        int node_;     // Current tree node (-1 = done)
+        size_t pos_;   // Position in its byStart / byEnd list
+    };
+
+    // True while the tree reflects the table (lets callers skip unchanged re-queries).
+    bool isCurrent() const { return !dirty_.load(std::memory_order_acquire); }
+
+private:
+    struct Interval {
+        int start, end;   // [start, end) in minutes, start < end
+        int id;
+    };
+    struct TreeNode {
+        int center;
+        std::vector<Interval> byStart;   // Intervals containing center, ascending start
+        std::vector<Interval> byEnd;     // Same intervals, descending end
+        int left, right;                 // Child indices into nodes_ (-1 = none)
+    };
+
+    int build(std::vector<Interval>& items) const;
+    void rebuild() const;
+    void ensureBuilt() const;                 // Lazy rebuild (first reader after a change)
+
+    std::unordered_map<int, std::pair<int, int>> shifts_;   // id -> (shiftStart, shiftEnd)
+    mutable std::vector<TreeNode> nodes_;
+    mutable int root_;
+    mutable std::atomic<bool> dirty_;
+    mutable std::mutex rebuildMutex_;   // Serialises the lazy rebuild between concurrent readers
+};
+
+#endif // SHIFT_INDEX_HPP
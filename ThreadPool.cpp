@@ -0,0 +1,52 @@
+// ThreadPool.cpp
+// Implementation of the fixed-size worker pool (see ThreadPool.hpp).
+
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned threads) : running_(0), stopping_(false) {
+    if (threads == 0) threads = thread::hardware_concurrency();
+    if (threads == 0) threads = 2;   // hardware_concurrency() may be unknown
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) workers_.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (thread& t : workers_) t.join();
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return tasks_.empty() && running_ == 0; });
+}
+
+void ThreadPool::workerLoop() {
+    unique_lock<mutex> lock(mutex_);
+    while (true) {
+        ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) return;   // Stopping and drained
+
+        function<void()> task = std::move(tasks_.front());
+        tasks_.pop_front();
+        running_++;
+        lock.unlock();
+        task();
+        lock.lock();
+        running_--;
+        if (running_ == 0 && tasks_.empty()) idle_.notify_all();
+    }
+}
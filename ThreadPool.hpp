@@ -0,0 +1,44 @@
+// ThreadPool.hpp
+// Fixed-size worker pool for the service mode's request handlers (see ServiceCore.hpp).
+// Data Structure Choice: FIFO TASK QUEUE (deque) + CONDITION VARIABLES
+// Why?
+// - Workers are started once and reused, so a request costs one queue push, not a thread spawn.
+// - FIFO hand-out keeps terminals fair: a session queues its next command behind everyone else's.
+// - wait() blocks until the queue is empty *and* no task is running, which is how the service
+//   knows every terminal has finished (tasks may submit follow-up tasks).
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = 0);   // 0 = one per hardware thread
+    ~ThreadPool();                               // Finishes queued tasks, then joins
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);     // O(1); safe from inside a task
+    void wait();                                 // Until idle (queue empty, nothing running)
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable ready_;   // Signals workers: task queued or stopping
+    std::condition_variable idle_;    // Signals wait(): last running task finished
+    int running_;
+    bool stopping_;
+};
+
+#endif // THREAD_POOL_HPP
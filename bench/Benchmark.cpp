@@ -0,0 +1,286 @@
+// bench/Benchmark.cpp
+// Micro-benchmarks for the four roles' core operations, driven through the headless APIs
+// (no menus, prompts or tickets), with synthetic data at scales 10^2 .. 10^6.
+// Build (from the repository root):
+//   g++ -std=c++17 -O2 -I. bench/Benchmark.cpp PatientAdmission.cpp Ambulance.cpp Emergency.cpp
+//       MedicalSupply.cpp Journal.cpp MappedFile.cpp BinarySnapshot.cpp ShiftIndex.cpp DutyClock.cpp
+//       Log.cpp EventBus.cpp Metrics.cpp PagedView.cpp PatientRegistry.cpp -pthread -o bench_main
+// Usage: ./bench_main [--max N] [--only patients|supplies|emergency|ambulances]
+//   --max N   largest scale (power of ten, default 10000). Up to 10^6 is supported but slow: every
+//             journaled module rewrites its whole snapshot each Journal::COMPACT_EVERY operations, so
+//             the mutating loops grow as O(n^2 / 256) (10^5 takes about three minutes).
+// Method:
+// - Every run works in a fresh temporary directory (its own data/), so the real data/ is untouched
+//   and each scale starts empty.
+// - Per-op latency is taken with steady_clock around each call into a pre-reserved sample buffer;
+//   ops/sec is ops / total wall time of the loop. Persistence (save / load CSV / load binary) is one
+//   timed operation per scale and is reported as records per second.
+// - Allocations are counted by replacing global operator new (relaxed atomic increment; includes
+//   the background compaction threads). Inputs (names, dates) are built before the timed loop.
+// - Output goes through Log at QUIET, so module messages are formatted into a null stream and
+//   never reach the terminal; only the result table is printed.
+
+#include "PatientAdmission.hpp"
+#include "MedicalSupply.hpp"
+#include "Emergency.hpp"
+#include "Ambulance.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+// ---- Allocation counter ----
+static atomic<unsigned long long> allocations(0);
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+// ---- Measurement ----
+struct Result {
+    string op;
+    long ops;
+    double seconds;
+    long long p50, p99, max;   // Nanoseconds per op (per record for bulk operations)
+    double allocsPerOp;
+};
+
+vector<Result> results;
+vector<long long> samples;   // Reused between measurements (reserved once per scale)
+
+long long percentile(vector<long long>& v, double pct) {
+    if (v.empty()) return 0;
+    size_t rank = static_cast<size_t>(pct / 100.0 * (v.size() - 1) + 0.5);
+    nth_element(v.begin(), v.begin() + rank, v.end());
+    return v[rank];
+}
+
+// Time op(i) for i in [0, n) individually.
+template <typename Op>
+void measure(const string& name, long n, Op op) {
+    samples.clear();
+    unsigned long long allocsBefore = allocations.load(memory_order_relaxed);
+    Clock::time_point start = Clock::now();
+    for (long i = 0; i < n; ++i) {
+        Clock::time_point t0 = Clock::now();
+        op(i);
+        samples.push_back(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - t0).count());
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    unsigned long long allocs = allocations.load(memory_order_relaxed) - allocsBefore;
+
+    Result r;
+    r.op = name;
+    r.ops = n;
+    r.seconds = seconds;
+    r.max = samples.empty() ? 0 : *max_element(samples.begin(), samples.end());
+    r.p99 = percentile(samples, 99);
+    r.p50 = percentile(samples, 50);
+    r.allocsPerOp = n ? static_cast<double>(allocs) / n : 0;
+    results.push_back(r);
+}
+
+// Time one bulk operation over `records` records (load/save); rates are per record.
+template <typename Op>
+void measureBulk(const string& name, long records, Op op) {
+    unsigned long long allocsBefore = allocations.load(memory_order_relaxed);
+    Clock::time_point start = Clock::now();
+    op();
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    unsigned long long allocs = allocations.load(memory_order_relaxed) - allocsBefore;
+
+    long long perRecord = records ? static_cast<long long>(seconds * 1e9 / records) : 0;
+    Result r;
+    r.op = name;
+    r.ops = records;
+    r.seconds = seconds;
+    r.p50 = r.p99 = r.max = perRecord;
+    r.allocsPerOp = records ? static_cast<double>(allocs) / records : 0;
+    results.push_back(r);
+}
+
+void printResults(long scale) {
+    cout << "\n=== n = " << scale << " ===\n"
+         << left << setw(30) << "operation" << right << setw(10) << "ops" << setw(14) << "ops/sec"
+         << setw(11) << "p50 ns" << setw(11) << "p99 ns" << setw(12) << "max ns" << setw(11) << "allocs/op"
+         << "\n";
+    for (const Result& r : results) {
+        double rate = r.seconds > 0 ? r.ops / r.seconds : 0;
+        cout << left << setw(30) << r.op << right << setw(10) << r.ops << setw(14) << fixed
+             << setprecision(0) << rate << setw(11) << r.p50 << setw(11) << r.p99 << setw(12) << r.max
+             << setw(11) << setprecision(2) << r.allocsPerOp << "\n";
+    }
+    cout.unsetf(ios::floatfield);
+    results.clear();
+}
+
+// A fresh, empty data/ directory in the current (temporary) working directory.
+void resetData() {
+    fs::remove_all("data");
+    fs::create_directories("data");
+}
+
+// ---- Role 1: admission queue ----
+void benchPatients(long n) {
+    resetData();
+    vector<string> names(n);
+    for (long i = 0; i < n; ++i) names[i] = "PATIENT " + to_string(i);
+
+    unique_ptr<PatientAdmission> pa(new PatientAdmission());
+    measure("patients.admit", n, [&](long i) { pa->admit(names[i], "Observation"); });
+    measureBulk("patients.save (compact)", n, [&] { pa.reset(); });
+    fs::remove("data/patients.bin");
+    measureBulk("patients.load csv", n, [&] { pa.reset(new PatientAdmission()); });
+    pa.reset();
+    measureBulk("patients.load binary", n, [&] { pa.reset(new PatientAdmission()); });
+    measure("patients.discharge", n, [&](long) { pa->dischargePatient(); });
+    pa.reset();
+}
+
+// ---- Role 2: supply stack + indexes ----
+void benchSupplies(long n) {
+    resetData();
+    long items = max(1L, n / 10);   // ~10 batches per item name
+    vector<string> names(items);
+    for (long i = 0; i < items; ++i) names[i] = "Item-" + to_string(i);
+    vector<MedicalSupply::Supply> batches(n);
+    for (long i = 0; i < n; ++i) {
+        MedicalSupply::Supply& s = batches[i];
+        s.id = 0;
+        s.name = names[i % items];
+        s.quantity = 10;
+        s.batch = "B" + to_string(i);
+        char date[16];
+        snprintf(date, sizeof date, "%04ld-%02ld-%02ld", 2027 + i % 5, 1 + i % 12, 1 + i % 28);
+        s.expiry = date;
+        s.notes = "synthetic";
+    }
+
+    unique_ptr<MedicalSupply> ms(new MedicalSupply());
+    measure("supplies.push", n, [&](long i) { ms->addSupply(batches[i]); });
+    measure("supplies.consume (FEFO)", n, [&](long i) { ms->consume(names[i % items], 1); });
+    measureBulk("supplies.save (compact)", n, [&] { ms.reset(); });
+    fs::remove("data/medical_supplies.bin");
+    measureBulk("supplies.load csv", n, [&] { ms.reset(new MedicalSupply()); });
+    ms.reset();
+    measureBulk("supplies.load binary", n, [&] { ms.reset(new MedicalSupply()); });
+    measure("supplies.pop (use last)", n, [&](long) {
+        const MedicalSupply::Supply* top = ms->peekTop();
+        if (top) ms->useLast(top->quantity);
+    });
+    ms.reset();
+}
+
+// ---- Role 3: triage heap ----
+void benchEmergency(long n) {
+    resetData();
+    vector<string> names(n);
+    for (long i = 0; i < n; ++i) names[i] = "CASE " + to_string(i);
+    mt19937 rng(42);
+    vector<int> ids;
+    ids.reserve(n);
+
+    unique_ptr<EmergencyDepartment> em(new EmergencyDepartment());
+    measure("emergency.log", n, [&](long i) {
+        ids.push_back(em->logCase(names[i], "Synthetic", 1 + static_cast<int>(i % 10)));
+    });
+    shuffle(ids.begin(), ids.end(), rng);
+    measure("emergency.updatePriority", n, [&](long i) {
+        em->setPriority(ids[i], 1 + static_cast<int>((i * 7) % 10));
+    });
+    measureBulk("emergency.save (compact)", n, [&] { em.reset(); });
+    fs::remove("data/emergency.bin");
+    measureBulk("emergency.load csv", n, [&] { em.reset(new EmergencyDepartment()); });
+    em.reset();
+    measureBulk("emergency.load binary", n, [&] { em.reset(new EmergencyDepartment()); });
+    measure("emergency.process", n, [&](long) { em->processCriticalCase(); });
+    em.reset();
+}
+
+// ---- Role 4: roster, shifts, duty index ----
+void benchAmbulances(long n) {
+    resetData();
+    vector<string> regs(n);
+    for (long i = 0; i < n; ++i) regs[i] = "AMB-" + to_string(i);
+    long queries = min(n, 10000L);   // Each on-duty query returns ~n/3 units: O(k) per call
+
+    unique_ptr<Ambulance> ad(new Ambulance());
+    measure("ambulances.register", n, [&](long i) { ad->registerAmbulance(regs[i], "Driver", "synthetic"); });
+    measure("ambulances.assignShift", n, [&](long i) {
+        int start = static_cast<int>((i * 37) % 1380);
+        ad->assignShift(static_cast<int>(i) + 1, start, min(1440, start + 60 + static_cast<int>(i % 420)));
+    });
+    measure("ambulances.rotate", n, [&](long) { ad->rotateShift(); });
+    measure("ambulances.lookup (by ID)", n, [&](long i) { ad->recordOf(static_cast<int>(i) + 1); });
+    measure("ambulances.onDutyAt", queries, [&](long i) { ad->onDutyAt(static_cast<int>((i * 13) % 1440)); });
+    measureBulk("ambulances.save (compact)", n, [&] { ad.reset(); });
+    fs::remove("data/ambulances.bin");
+    measureBulk("ambulances.load csv", n, [&] { ad.reset(new Ambulance()); });
+    ad.reset();
+    measureBulk("ambulances.load binary", n, [&] { ad.reset(new Ambulance()); });
+    ad.reset();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    long maxScale = 10000;
+    string only;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--max" && i + 1 < argc) maxScale = atol(argv[++i]);
+        else if (arg == "--only" && i + 1 < argc) only = argv[++i];
+        else {
+            cerr << "Usage: " << argv[0] << " [--max N] [--only patients|supplies|emergency|ambulances]\n";
+            return 2;
+        }
+    }
+
+    Log::init();
+    Log::setLevel(Log::QUIET);
+    Log::setTickets(false);
+
+    fs::path root = fs::current_path();
+    fs::path work = fs::temp_directory_path() / ("hms-bench-" + to_string(Clock::now().time_since_epoch().count()));
+    fs::create_directories(work);
+    fs::current_path(work);
+    cout << "Benchmark directory: " << work.string() << "\n";
+
+    for (long n = 100; n <= maxScale; n *= 10) {
+        samples.reserve(n);
+        if (only.empty() || only == "patients") benchPatients(n);
+        if (only.empty() || only == "supplies") benchSupplies(n);
+        if (only.empty() || only == "emergency") benchEmergency(n);
+        if (only.empty() || only == "ambulances") benchAmbulances(n);
+        printResults(n);
+    }
+
+    fs::current_path(root);
+    fs::remove_all(work);
+    return 0;
+}
@@ -4,6 +4,14 @@
 #include "MedicalSupply.hpp"
 #include "Emergency.hpp"
 #include "Ambulance.hpp"
+#include "DispatchEngine.hpp"
+#include "BatchMode.hpp"
+#include "ServiceCore.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include <cstdlib>
+#include <string>
+#include <vector>
 using namespace std;
 
 class MedicalSupply;
@@ -11,11 +19,55 @@ class Emergency;
 class Ambulance;
 class PatientAdmission;
 
-int main() {
+// --metrics <file>: written from atexit, i.e. after every module's destructor (final saves included).
+static string metricsPath;
+static void writeMetricsOnExit() {
+    if (!Metrics::writeSnapshot(metricsPath)) cerr << "Could not write metrics to '" << metricsPath << "'.\n";
+}
+
+int main(int argc, char* argv[]) {
+    Log::init();  // Buffered console: nothing on the hot paths flushes per line
+
+    // Options: --batch <file|->  headless mode (no menus, prompts or tickets; output flushed at the end)
+    //          --serve <file>...    concurrent terminals, one script each; --threads N sizes the pool
+    //          --quiet / --verbose  verbosity (default: verbose interactively, normal when headless)
+    //          --no-tickets         skip admission ticket rendering
+    //          --metrics <file>     write operation latencies / queue gauges there at exit
+    const char* batchSource = nullptr;
+    vector<string> terminals;
+    unsigned threads = 0;
+    int verbosity = -1;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--batch" && i + 1 < argc) batchSource = argv[++i];
+        else if (arg == "--serve") {
+            while (i + 1 < argc && argv[i + 1][0] != '-') terminals.push_back(argv[++i]);
+        }
+        else if (arg == "--threads" && i + 1 < argc) threads = static_cast<unsigned>(atoi(argv[++i]));
+        else if (arg == "--quiet") verbosity = Log::QUIET;
+        else if (arg == "--verbose") verbosity = Log::VERBOSE;
+        else if (arg == "--no-tickets") Log::setTickets(false);
+        else if (arg == "--metrics" && i + 1 < argc) metricsPath = argv[++i];
+        else {
+            cerr << "Usage: " << argv[0] << " [--batch <file|-> | --serve <file>... [--threads N]]"
+                 << " [--quiet|--verbose] [--no-tickets] [--metrics <file>]\n";
+            return 2;
+        }
+    }
+
+    if (!metricsPath.empty()) atexit(writeMetricsOnExit);
+
+    if (batchSource || !terminals.empty()) {
+        Log::setLevel(verbosity < 0 ? Log::NORMAL : static_cast<Log::Level>(verbosity));
+        return batchSource ? runBatch(batchSource) : runService(terminals, threads);
+    }
+    if (verbosity >= 0) Log::setLevel(static_cast<Log::Level>(verbosity));
+
     PatientAdmission pa;
     MedicalSupply ms;  
     EmergencyDepartment em;
     Ambulance ad; 
+    DispatchEngine dispatch(em, ad);
 
     int choice;
 
@@ -27,6 +79,7 @@ int main() {
         cout << "2. Medical Supply Management (Role 2: Linked List + LIFO Stack)\n";
         cout << "3. Emergency Department (Role 3: Array + Priority Queue)\n";
         cout << "4. Ambulance Dispatch (Role 4: Linked List + Circular Queue)\n";
+        cout << "5. Emergency Dispatch (Roles 3 + 4: send best unit to most critical case)\n";
         cout << "0. Exit\n";
         cout << "----------------------------------------------\n";
         cout << "Enter choice: ";
@@ -58,6 +111,11 @@ int main() {
                 ad.displayMenu();
                 break;
 
+            case 5:
+                cout << "\n[ Emergency Dispatch ]\n";
+                dispatch.displayMenu();
+                break;
+
             case 0:
                 cout << "\nExiting system... Goodbye.\n";
                 break;
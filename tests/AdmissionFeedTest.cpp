@@ -0,0 +1,93 @@
+// tests/AdmissionFeedTest.cpp
+// Regression check for the admission -> triage feed (EventBus::patientAdmitted()).
+// Build (from the repository root):
+//   g++ -std=c++17 -I. tests/AdmissionFeedTest.cpp PatientAdmission.cpp Emergency.cpp Journal.cpp
+//       MappedFile.cpp BinarySnapshot.cpp Log.cpp EventBus.cpp Metrics.cpp PagedView.cpp PatientRegistry.cpp
+//       -pthread -o admission_feed_test
+// Usage: ./admission_feed_test   (exit code 0 = pass; runs in a temporary directory, data/ untouched)
+// Scenarios:
+// - Collision: admit (ID 1), log an ED case (ID 2), admit again (admission ID 2): both admissions
+//   are pending, each under a case ID of its own.
+// - Reuse: the admitted patients are processed and discharged; after a restart Role 1 issues
+//   admission ID 1 again, and the new patient still reaches triage.
+// - Resync: importing patients.txt adds nothing for admissions that already have a case, pending or
+//   processed, across a restart.
+
+#include "Emergency.hpp"
+#include "Log.hpp"
+#include "PatientAdmission.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const string& what) {
+    cout << (ok ? "[pass] " : "[FAIL] ") << what << "\n";
+    if (!ok) failures++;
+}
+
+void collision() {
+    PatientAdmission pa;
+    EmergencyDepartment ed;
+    check(pa.admit("Ann", "Fever") == 1, "first admission is ID 1");
+    check(ed.logCase("Bob", "Heart Attack", 0) > 0, "ED logs a case of its own");
+    check(pa.admit("Cal", "Cough") == 2, "second admission is ID 2");
+    ed.drainIntake();   // pendingCount() also counts undrained intake
+    check(ed.pendingCount() == 3, "both admissions and the ED case are pending");
+
+    ed.loadPatientsFromFile();
+    check(ed.pendingCount() == 3, "resync skips admissions already pending");
+
+    EmergencyCase c;
+    int served = 0;
+    while (ed.takeNextCase(c)) served++;
+    check(served == 3, "every case can be processed");
+    check(pa.dischargeN(2) == 2, "both patients discharged");
+}   // ED: case IDs 1-3 retired; queue empty, so Role 1 starts again at ID 1
+
+void reuse() {
+    PatientAdmission pa;
+    EmergencyDepartment ed;
+    check(pa.admit("Dee", "Rash") == 1, "after a restart Role 1 reissues ID 1");
+    ed.drainIntake();
+    check(ed.pendingCount() == 1, "the new patient reaches triage");
+    EmergencyCase c;
+    check(ed.takeNextCase(c) && c.patientName == "DEE" && c.admissionID == 1, "case keeps its admission ID");
+}   // Dee stays admitted; the case is processed
+
+void resyncAfterRestart() {
+    PatientAdmission pa;
+    EmergencyDepartment ed;
+    check(pa.getQueueSize() == 1, "Dee is still admitted");
+    ed.loadPatientsFromFile();
+    check(ed.pendingCount() == 0, "resync does not triage a processed admission again");
+}
+
+} // namespace
+
+int main() {
+    Log::init();
+    Log::setLevel(Log::QUIET);
+
+    fs::path root = fs::current_path();
+    fs::path work = fs::temp_directory_path() /
+                    ("hms-admission-test-" + to_string(chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(work / "data");
+    fs::current_path(work);
+
+    collision();
+    reuse();
+    resyncAfterRestart();
+
+    fs::current_path(root);
+    fs::remove_all(work);
+    cout << (failures == 0 ? "All checks passed.\n" : "Some checks FAILED.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+// tests/JournalRotateTest.cpp
+// Regression check for Journal::rotate when an earlier compaction archive is still on disk.
+// Build (from the repository root):
+//   g++ -std=c++17 -I. tests/JournalRotateTest.cpp Emergency.cpp Journal.cpp MappedFile.cpp
+//       BinarySnapshot.cpp Log.cpp EventBus.cpp Metrics.cpp PagedView.cpp PatientRegistry.cpp
+//       -pthread -o journal_rotate_test
+// Usage: ./journal_rotate_test   (exit code 0 = pass; runs in a temporary directory, data/ untouched)
+// Scenarios:
+// - Journal level: rotate, leave the archive (failed compaction), append, rotate again (the archive
+//   also has a torn tail): every complete entry is still in the archive, in order.
+// - Emergency Department: a compaction that cannot write its snapshot leaves emergency.log.1; the
+//   next run logs another case and compacts (fails) again; a third run must reload both cases.
+// - Retired file: compaction appends only newly processed / dispatched cases to
+//   emergency_retired.txt; a row a failed compaction could not append comes back from the archive.
+
+#include "Emergency.hpp"
+#include "Journal.hpp"
+#include "Log.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const string& what) {
+    cout << (ok ? "[pass] " : "[FAIL] ") << what << "\n";
+    if (!ok) failures++;
+}
+
+vector<string> entriesOf(const string& path) {
+    vector<string> out;
+    Journal::replayFile(path, [&out](string_view e) { out.push_back(string(e)); });
+    return out;
+}
+
+void journalLevel() {
+    {
+        Journal j("t.log");
+        j.append("L,1");
+        j.append("L,2");
+        check(j.rotate("t.log.1"), "first rotate");       // Compaction "fails": archive stays
+        j.append("L,3");
+        FILE* f = fopen("t.log.1", "ab");                  // Crash mid-write left a torn tail
+        fputs("L,tor", f);
+        fclose(f);
+        check(j.rotate("t.log.1"), "second rotate over a leftover archive");
+        j.append("L,4");
+    }
+    Journal reloaded("t.log");
+    vector<string> archived = entriesOf("t.log.1");
+    vector<string> live = entriesOf("t.log");
+    check(archived == vector<string>({ "L,1", "L,2", "L,3" }), "archive keeps old and new entries, torn tail cut");
+    check(live == vector<string>({ "L,4" }), "live journal holds only entries after the rotate");
+}
+
+void emergencyLevel() {
+    fs::create_directories("data/emergency.txt.tmp");   // Snapshot temp path is a directory: writes fail
+    {
+        EmergencyDepartment ed;
+        check(ed.logCase("First", "Heart Attack", 0) > 0, "run 1 logs a case");
+    }   // Final compaction rotates, then fails
+    check(fs::exists("data/emergency.log.1"), "failed compaction leaves the archive");
+    {
+        EmergencyDepartment ed;
+        check(ed.pendingCount() == 1, "run 2 replays the archive");
+        check(ed.logCase("Second", "Severe Burn", 0) > 0, "run 2 logs a case");
+    }   // Rotates again (over the archive), fails again
+    fs::remove("data/emergency.txt.tmp");
+    EmergencyDepartment ed;   // Destroyed (final compaction) before main leaves the work directory
+    check(ed.pendingCount() == 2, "run 3 reloads both cases");
+}
+
+void retiredLevel() {
+    int first = 0;
+    {
+        EmergencyDepartment ed;
+        EmergencyCase c;
+        while (ed.takeNextCase(c)) first = c.patientID;   // Retires both cases of emergencyLevel()
+    }
+    vector<string> rows = entriesOf("data/emergency_retired.txt");
+    check(rows.size() == 2, "compaction appends the two processed cases");
+
+    fs::create_directories("data/emergency.txt.tmp");   // This compaction fails before appending
+    {
+        EmergencyDepartment ed;
+        check(ed.recordDispatch(first, 7), "dispatch recorded on a processed case");
+    }   // The archive keeps the D record
+    fs::remove("data/emergency.txt.tmp");
+    {
+        EmergencyDepartment ed;   // Replays the archive; its compaction appends the row
+    }
+    EmergencyDepartment ed;
+    rows = entriesOf("data/emergency_retired.txt");
+    check(rows.size() == 3 && rows.back() == to_string(first) + ",7,-1", "dispatch row appended by the next compaction");
+    check(ed.dispatchedUnit(first) == 7, "reload sees the dispatched unit");
+    check(!fs::exists("data/emergency.log.1"), "archive dropped once the rows are in place");
+}
+
+} // namespace
+
+int main() {
+    Log::init();
+    Log::setLevel(Log::QUIET);
+
+    fs::path root = fs::current_path();
+    fs::path work = fs::temp_directory_path() /
+                    ("hms-journal-test-" + to_string(chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(work / "data");
+    fs::current_path(work);
+
+    journalLevel();
+    emergencyLevel();
+    retiredLevel();
+
+    fs::current_path(root);
+    fs::remove_all(work);
+    cout << (failures == 0 ? "All checks passed.\n" : "Some checks FAILED.\n");
+    return failures == 0 ? 0 : 1;
+}